@@ -0,0 +1,338 @@
+// ========================================================================
+//
+// The Forth interpreter-compiler by Prof. Boguslaw Cyganek (C) 2021
+//
+// The software is supplied as is and for educational purposes
+// without any guarantees nor responsibility of its use in any application.
+//
+// ========================================================================
+
+
+#pragma once
+
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <algorithm>
+
+
+#include "BaseDefinitions.h"
+
+
+
+namespace BCForth
+{
+
+
+
+	// The buffer of each open file - the reads and writes go through it in large blocks,
+	// which matters much for the SPIFFS on the ESP32, where each fread or fwrite is slow.
+#ifdef ESP_PLATFORM
+	constexpr size_type kFileBufferSize { 4 * 1024 };
+#else
+	constexpr size_type kFileBufferSize { 64 * 1024 };
+#endif
+
+
+	// The ior codes are the errno values (0 means OK)
+	[[nodiscard]] inline int FileIor( void ) { return errno != 0 ? errno : EIO; }
+
+
+
+	// A file with its own buffer, which holds either the data read ahead, or the data still to be written.
+	// The std::FILE has no buffer of its own, so the position in the file is always known.
+	class TBufferedFile
+	{
+
+	public:
+
+		struct ReadLineResult
+		{
+			size_type		fLen {};
+			bool			fFlag {};		// false - the end of the file, and nothing read
+			int				fIor {};
+		};
+
+	private:
+
+		std::unique_ptr< std::FILE, decltype( & std::fclose ) >		fFile;
+
+		std::unique_ptr< RawByte [] >	fBuf { std::make_unique< RawByte [] >( kFileBufferSize ) };
+
+		size_type		fBegin {};			// the data not consumed yet is [ fBegin, fEnd )
+		size_type		fEnd {};
+
+		bool			fWriting {};		// true - [ 0, fEnd ) waits to be written
+
+	public:
+
+		TBufferedFile( std::FILE * f ) : fFile( f, & std::fclose )
+		{
+			std::setvbuf( fFile.get(), nullptr, _IONBF, 0 );
+		}
+
+		TBufferedFile( const TBufferedFile & ) = delete;
+		TBufferedFile & operator = ( const TBufferedFile & ) = delete;
+
+		~TBufferedFile()
+		{
+			if( fFile )
+				( void ) Flush();
+		}
+
+
+	private:
+
+		// Read ahead into the empty buffer - returns the number of bytes read
+		size_type Fill( void )
+		{
+			fBegin = 0;
+			fEnd = std::fread( fBuf.get(), 1, kFileBufferSize, fFile.get() );
+			return fEnd;
+		}
+
+		// Before the writes - the data read ahead is given back, so the file position is where the reader is
+		// (the fseek is also needed by the std::FILE between a read and a write)
+		int DropReadAhead( void )
+		{
+			const auto ahead { static_cast< long >( fEnd - fBegin ) };
+			fBegin = fEnd = 0;
+			return std::fseek( fFile.get(), - ahead, SEEK_CUR ) == 0 ? 0 : FileIor();
+		}
+
+		int StartWriting( void )
+		{
+			if( fWriting )
+				return 0;
+			const int ior { DropReadAhead() };
+			fWriting = ior == 0;
+			return ior;
+		}
+
+		int StartReading( void )
+		{
+			if( ! fWriting )
+				return 0;
+			const int ior { Flush() };
+			fWriting = false;
+			return ior;
+		}
+
+	public:
+
+		// Writes the buffered data to the file
+		[[nodiscard]] int Flush( void )
+		{
+			if( ! fWriting )
+				return 0;
+			const auto n { fEnd };
+			fEnd = 0;
+			if( n > 0 && std::fwrite( fBuf.get(), 1, n, fFile.get() ) != n )
+				return FileIor();
+			return std::fflush( fFile.get() ) == 0 ? 0 : FileIor();
+		}
+
+		[[nodiscard]] int Close( void )
+		{
+			const int ior { Flush() };
+			return std::fclose( fFile.release() ) == 0 ? ior : FileIor();
+		}
+
+
+		// Reads up to n bytes to dst - less only at the end of the file.
+		// The large reads go straight to dst, with no copying through the buffer.
+		[[nodiscard]] std::pair< size_type, int > Read( RawByte * dst, size_type n )
+		{
+			if( const int ior { StartReading() }; ior != 0 )
+				return { 0, ior };
+
+			size_type done { std::min( n, fEnd - fBegin ) };
+			std::memcpy( dst, fBuf.get() + fBegin, done );
+			fBegin += done;
+
+			if( n - done >= kFileBufferSize )
+			{
+				done += std::fread( dst + done, 1, n - done, fFile.get() );
+			}
+			else
+			{
+				while( done < n && Fill() > 0 )
+				{
+					const auto k { std::min( n - done, fEnd ) };
+					std::memcpy( dst + done, fBuf.get(), k );
+					fBegin = k;
+					done += k;
+				}
+			}
+
+			return { done, std::ferror( fFile.get() ) != 0 ? FileIor() : 0 };
+		}
+
+
+		// Reads one line, with no end of line, to dst of n bytes. The LF and CR LF ends are recognized.
+		// A longer line is given in parts of n bytes. The memchr looks for the end of the line,
+		// and the line goes from the buffer to dst with one memcpy.
+		[[nodiscard]] ReadLineResult ReadLine( RawByte * dst, size_type n )
+		{
+			if( const int ior { StartReading() }; ior != 0 )
+				return ReadLineResult { .fIor = ior };
+
+			size_type done {};
+			bool any {};
+			for( ;; )
+			{
+				if( fBegin == fEnd && Fill() == 0 )
+				{
+					if( std::ferror( fFile.get() ) != 0 )
+						return ReadLineResult { done, false, FileIor() };
+					return ReadLineResult { done, any, 0 };		// the last line, with no end
+				}
+				any = true;
+
+				const auto avail { fEnd - fBegin };
+				const auto * src { fBuf.get() + fBegin };
+				if( done == n )
+				{
+					// The line fills dst - its end (if just here) is left for the next call, which gives 0 bytes.
+					// Only the CR LF split between the calls is taken now, so u2 < u1 tells the line ended.
+					if( n > 0 && dst[ n - 1 ] == '\r' && src[ 0 ] == '\n' )
+						return ++ fBegin, ReadLineResult { n - 1, true, 0 };
+					return ReadLineResult { n, true, 0 };
+				}
+
+				const auto room { std::min( avail, n - done ) };
+				if( const auto * eol { static_cast< const RawByte * >( std::memchr( src, '\n', room ) ) } )
+				{
+					const auto k { static_cast< size_type >( eol - src ) };
+					std::memcpy( dst + done, src, k );
+					fBegin += k + 1;
+					done += k;
+					if( done > 0 && dst[ done - 1 ] == '\r' )
+						-- done;
+					return ReadLineResult { done, true, 0 };
+				}
+
+				std::memcpy( dst + done, src, room );
+				fBegin += room;
+				done += room;
+			}
+		}
+
+
+		[[nodiscard]] int Write( const RawByte * src, size_type n )
+		{
+			if( const int ior { StartWriting() }; ior != 0 )
+				return ior;
+
+			if( fEnd + n > kFileBufferSize )
+			{
+				if( const int ior { Flush() }; ior != 0 )
+					return ior;
+				if( n >= kFileBufferSize )		// does not fit anyway - it goes to the file directly
+					return std::fwrite( src, 1, n, fFile.get() ) == n ? 0 : FileIor();
+			}
+
+			std::memcpy( fBuf.get() + fEnd, src, n );
+			fEnd += n;
+			return 0;
+		}
+
+
+		[[nodiscard]] std::pair< size_type, int > Position( void )
+		{
+			const long pos { std::ftell( fFile.get() ) };
+			if( pos < 0 )
+				return { 0, FileIor() };
+			const auto p { static_cast< size_type >( pos ) };
+			return { fWriting ? p + fEnd : p - ( fEnd - fBegin ), 0 };
+		}
+
+		[[nodiscard]] int Reposition( size_type pos )
+		{
+			if( const int ior { fWriting ? Flush() : 0 }; ior != 0 )
+				return ior;
+			fBegin = fEnd = 0;
+			fWriting = false;
+			return std::fseek( fFile.get(), static_cast< long >( pos ), SEEK_SET ) == 0 ? 0 : FileIor();
+		}
+
+		[[nodiscard]] std::pair< size_type, int > Size( void )
+		{
+			if( const int ior { Flush() }; ior != 0 )
+				return { 0, ior };
+
+			const long cur { std::ftell( fFile.get() ) };
+			if( cur < 0 || std::fseek( fFile.get(), 0, SEEK_END ) != 0 )
+				return { 0, FileIor() };
+			const long end { std::ftell( fFile.get() ) };
+			if( end < 0 || std::fseek( fFile.get(), cur, SEEK_SET ) != 0 )
+				return { 0, FileIor() };
+			return { static_cast< size_type >( end ), 0 };
+		}
+
+	};
+
+
+
+
+	// The open files, known by their fileids - a fileid which was closed (or never opened) is not accepted.
+	// The files still open at the end are flushed and closed.
+	class TOpenFiles
+	{
+
+		std::unordered_map< const TBufferedFile *, std::unique_ptr< TBufferedFile > >		fFiles;
+
+	public:
+
+		// The fam codes of the R/O, W/O, R/W and BIN words
+		enum EFileAccess : size_type { kReadOnly = 0, kWriteOnly = 1, kReadWrite = 2, kBinary = 4 };
+
+		// OPEN-FILE needs the file to exist, CREATE-FILE makes it empty
+		[[nodiscard]] std::pair< TBufferedFile *, int > Open( const std::string & path, size_type fam, bool create )
+		{
+			static constexpr const char * kOpenModes[] { "rb", "r+b", "r+b" };
+			static constexpr const char * kCreateModes[] { "w+b", "wb", "w+b" };
+
+			const auto access { fam & ~ size_type { kBinary } };
+			if( access > kReadWrite )
+				return { nullptr, EINVAL };
+
+			errno = 0;
+			std::FILE * f { std::fopen( path.c_str(), create ? kCreateModes[ access ] : kOpenModes[ access ] ) };
+			if( f == nullptr )
+				return { nullptr, FileIor() };
+
+			auto file { std::make_unique< TBufferedFile >( f ) };
+			auto * id { file.get() };
+			fFiles.emplace( id, std::move( file ) );
+			return { id, 0 };
+		}
+
+		// nullptr if there is no such a file open
+		[[nodiscard]] TBufferedFile * Find( const void * fileid ) const
+		{
+			const auto pos { fFiles.find( static_cast< const TBufferedFile * >( fileid ) ) };
+			return pos != fFiles.end() ? pos->second.get() : nullptr;
+		}
+
+		[[nodiscard]] int Close( const void * fileid )
+		{
+			const auto pos { fFiles.find( static_cast< const TBufferedFile * >( fileid ) ) };
+			if( pos == fFiles.end() )
+				return EBADF;
+			const int ior { pos->second->Close() };
+			fFiles.erase( pos );
+			return ior;
+		}
+
+	};
+
+
+
+}	// The end of the BCForth namespace
+
+
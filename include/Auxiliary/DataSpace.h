@@ -0,0 +1,151 @@
+// ========================================================================
+//
+// The Forth interpreter-compiler by Prof. Boguslaw Cyganek (C) 2021
+//
+// The software is supplied as is and for educational purposes
+// without any guarantees nor responsibility of its use in any application.
+//
+// ========================================================================
+
+
+#pragma once
+
+
+#include <memory>
+#include <cstring>
+#include <cstdint>
+#include <bit>
+#include <type_traits>
+
+
+#include "BaseDefinitions.h"
+
+
+
+namespace BCForth
+{
+
+
+
+	// The default size of the data space (in bytes)
+#ifdef ESP_PLATFORM
+	constexpr size_type kDataSpaceSize { 32 * 1024 };
+#else
+	constexpr size_type kDataSpaceSize { 1024 * 1024 };
+#endif
+
+	// The max alignment of HERE (a page) - e.g. 64 for a cache line, or 16, 32 for the SIMD loads
+	constexpr CellType kMaxDataAlignment { 4096 };
+
+
+
+	// The Forth's data space - one contiguous block of memory for the data of CREATE, VARIABLE, ALLOT, , (comma), etc.
+	// It is allocated once and never grows, so the data addresses, once left on the stack, stay valid.
+	// HERE is the first free byte - everything below it is in use.
+	//
+	// Not thread safe - as the rest of the Forth's dictionary.
+	class TDataSpace
+	{
+		std::unique_ptr< RawByte [] >	fData;
+
+		size_type						fSize {};
+
+		size_type						fHere {};			// the offset of the first free byte
+
+		size_type						fDataFieldMark {};	// the HERE of the last CREATE, until its word is entered
+		bool							fHasDataFieldMark { false };
+
+	public:
+
+		explicit TDataSpace( size_type size = kDataSpaceSize ) : fData( new RawByte [ size ] {} ), fSize( size ) {}
+
+		TDataSpace( const TDataSpace & ) = delete;
+		TDataSpace & operator = ( const TDataSpace & ) = delete;
+
+	public:
+
+		[[nodiscard]] RawByte * Here( void ) { return fData.get() + fHere; }
+
+		[[nodiscard]] size_type GetSize( void ) const { return fSize; }
+
+		[[nodiscard]] size_type Unused( void ) const { return fSize - fHere; }
+
+		// The offset of HERE, e.g. to roll it back later with SetHereOffset()
+		[[nodiscard]] size_type GetHereOffset( void ) const { return fHere; }
+
+		void SetHereOffset( size_type offset )
+		{
+			if( offset < fHere )
+				fHere = offset;		// only backwards
+		}
+
+	public:
+
+		// The address rounded up to the alignment (a power of 2)
+		[[nodiscard]] static constexpr CellType Aligned( CellType addr, CellType alignment = sizeof( CellType ) )
+		{
+			return ( addr + alignment - 1 ) & ~ ( alignment - 1 );
+		}
+
+		// Reserves n bytes at HERE (zeroed) and returns their address. A negative n gives the bytes back.
+		RawByte * Allot( SignedIntType n )
+		{
+			auto * first { Here() };
+
+			if( n >= 0 )
+			{
+				if( static_cast< size_type >( n ) > Unused() )
+					throw ForthError( "data space full" );
+
+				std::memset( first, 0, static_cast< size_type >( n ) );
+				fHere += static_cast< size_type >( n );
+			}
+			else
+			{
+				if( static_cast< size_type >( - n ) > fHere )
+					throw ForthError( "ALLOT below the data space" );
+
+				fHere -= static_cast< size_type >( - n );
+			}
+
+			return first;
+		}
+
+		// Moves HERE to the next address aligned to the alignment (a power of 2, up to kMaxDataAlignment)
+		void Align( CellType alignment = sizeof( CellType ) )
+		{
+			if( ! std::has_single_bit( alignment ) || alignment > kMaxDataAlignment )
+				throw ForthError( "wrong alignment - a power of 2, up to 4096, expected" );
+
+			const auto here { reinterpret_cast< CellType >( Here() ) };
+			Allot( static_cast< SignedIntType >( Aligned( here, alignment ) - here ) );
+		}
+
+		// Stores the value at HERE and moves HERE past it
+		template < typename V >
+		requires std::is_trivially_copyable_v< V >
+		void Comma( V val )
+		{
+			std::memcpy( Allot( sizeof( V ) ), & val, sizeof( V ) );		// HERE need not be aligned
+		}
+
+	public:
+
+		// CREATE marks the start of its data field, which is then given to the word it makes
+		// (a roll-back to that word frees also the data laid down before the word was entered)
+		void MarkDataField( void ) { fDataFieldMark = fHere, fHasDataFieldMark = true; }
+
+		[[nodiscard]] size_type TakeDataFieldMark( void )
+		{
+			const auto mark { fHasDataFieldMark ? fDataFieldMark : fHere };
+			fHasDataFieldMark = false;
+			return mark;
+		}
+
+	};
+
+
+
+}	// The end of the BCForth namespace
+
+
@@ -0,0 +1,193 @@
+// ========================================================================
+//
+// The Forth interpreter-compiler by Prof. Boguslaw Cyganek (C) 2021
+//
+// The software is supplied as is and for educational purposes
+// without any guarantees nor responsibility of its use in any application.
+//
+// ========================================================================
+
+
+#pragma once
+
+
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <cstdint>
+#include <string_view>
+
+
+#include "BaseDefinitions.h"
+
+
+
+namespace BCForth
+{
+
+
+
+	// A read-only perfect hash table made of a word list, to find the words in one probe.
+	// It only points to the elements of the word list (Dict is a std::unordered_map, so they do not move),
+	// which is still there and takes the words entered later.
+	//
+	// This is the hash-and-displace scheme: the names are split into buckets by their hash,
+	// and for each bucket a displacement is found which puts all its names in the free slots.
+	// A lookup is then: hash the name, read the bucket's displacement, go to the slot and compare the name.
+	template < typename Dict >
+	class TFrozenWordTableFor
+	{
+	public:
+
+		using value_type = typename Dict::value_type;
+
+	private:
+
+		static constexpr size_type	kNamesPerBucket { 4 };
+		static constexpr std::uint32_t	kMaxDisplacement { 1u << 16 };
+
+		std::vector< std::uint32_t >	fDisplacements;		// one for each bucket
+		std::vector< value_type * >		fSlots;				// nullptr for an empty slot
+
+		size_type						fNumOfNewWords {};	// words entered to the word list after it was frozen
+
+	private:
+
+		[[nodiscard]] static constexpr std::uint64_t Mix( size_t h, std::uint32_t d )
+		{
+			auto x { static_cast< std::uint64_t >( h ) ^ ( d * 0x9E3779B97F4A7C15ull ) };
+			x ^= x >> 33;
+			x *= 0xFF51AFD7ED558CCDull;
+			x ^= x >> 33;
+			return x;
+		}
+
+		[[nodiscard]] size_type Bucket( size_t h ) const { return Mix( h, 0 ) % fDisplacements.size(); }
+
+		[[nodiscard]] size_type Slot( size_t h, std::uint32_t d ) const { return Mix( h, d ) % fSlots.size(); }
+
+		// Returns false if some bucket could not be placed
+		bool Place( const std::vector< size_t > & hashes, const std::vector< value_type * > & elems )
+		{
+			std::vector< std::vector< size_type > >	buckets( fDisplacements.size() );
+			for( size_type i {}; i < hashes.size(); ++ i )
+				buckets[ Bucket( hashes[ i ] ) ].push_back( i );
+
+			// The biggest buckets go first, while there are many free slots
+			std::vector< size_type >	order( buckets.size() );
+			std::iota( order.begin(), order.end(), 0 );
+			std::ranges::stable_sort( order, [ & buckets ] ( auto a, auto b ) { return buckets[ a ].size() > buckets[ b ].size(); } );
+
+			std::vector< size_type >	slots;
+			for( const auto b : order )
+			{
+				if( buckets[ b ].empty() )
+					break;
+
+				std::uint32_t d { 1 };
+				for( ; d < kMaxDisplacement; ++ d )
+				{
+					slots.clear();
+					for( const auto i : buckets[ b ] )
+					{
+						const auto s { Slot( hashes[ i ], d ) };
+						if( fSlots[ s ] != nullptr || std::ranges::find( slots, s ) != slots.end() )
+							break;
+						slots.push_back( s );
+					}
+
+					if( slots.size() == buckets[ b ].size() )
+						break;		// all names of this bucket found free slots
+				}
+
+				if( d == kMaxDisplacement )
+					return false;
+
+				fDisplacements[ b ] = d;
+				for( size_type k {}; k < slots.size(); ++ k )
+					fSlots[ slots[ k ] ] = elems[ buckets[ b ][ k ] ];
+			}
+
+			return true;
+		}
+
+	public:
+
+		// Builds the table of all the words in the dict. Throws if this is not possible (e.g. the same hash of two names).
+		void Build( Dict & dict )
+		{
+			std::vector< size_t >			hashes;
+			std::vector< value_type * >		elems;
+			hashes.reserve( dict.size() );
+			elems.reserve( dict.size() );
+			for( auto & elem : dict )
+				hashes.push_back( WordNameHash()( elem.first ) ), elems.push_back( & elem );
+
+			Clear();
+			if( elems.empty() )
+				return;
+
+			// Start with (almost) one slot per name, and add some space if a bucket cannot be placed
+			for( size_type num_of_slots { elems.size() + elems.size() / 16 + 1 }; num_of_slots < 4 * elems.size() + 16; num_of_slots += num_of_slots / 4 + 1 )
+			{
+				fDisplacements.assign( elems.size() / kNamesPerBucket + 1, 0 );
+				fSlots.assign( num_of_slots, nullptr );
+
+				if( Place( hashes, elems ) )
+					return;
+			}
+
+			Clear();
+			throw ForthError( "cannot freeze the dictionary" );
+		}
+
+		void Clear( void )
+		{
+			fDisplacements.clear();
+			fSlots.clear();
+			fNumOfNewWords = 0;
+		}
+
+		[[nodiscard]] bool IsFrozen( void ) const { return fSlots.size() > 0; }
+
+	public:
+
+		// Returns nullptr if the name is not in the table, with no allocation
+		[[nodiscard]] value_type * Find( std::string_view name ) const
+		{
+			if( ! IsFrozen() )
+				return nullptr;
+
+			const auto h { WordNameHash()( name ) };
+			auto * elem { fSlots[ Slot( h, fDisplacements[ Bucket( h ) ] ) ] };
+			return elem != nullptr && WordNameEqual()( elem->first, name ) ? elem : nullptr;
+		}
+
+		// True if the table gives the final answer, i.e. no words were entered after it was built
+		[[nodiscard]] bool IsComplete( void ) const { return IsFrozen() && fNumOfNewWords == 0; }
+
+		// To be called when a new name is entered to the word list (not when a word is redefined, since the element stays the same)
+		void NewWordEntered( void ) { ++ fNumOfNewWords; }
+
+		// To be called before the element is erased from the word list
+		void WordErased( const value_type * elem )
+		{
+			if( ! IsFrozen() )
+				return;
+
+			const auto h { WordNameHash()( elem->first ) };
+			if( auto & slot = fSlots[ Slot( h, fDisplacements[ Bucket( h ) ] ) ]; slot == elem )
+				slot = nullptr;
+			else if( fNumOfNewWords > 0 )
+				-- fNumOfNewWords;
+		}
+
+		[[nodiscard]] size_type GetNumOfSlots( void ) const { return fSlots.size(); }
+
+	};
+
+
+
+}	// The end of the BCForth namespace
+
+
@@ -0,0 +1,180 @@
+// ========================================================================
+//
+// The Forth interpreter-compiler by Prof. Boguslaw Cyganek (C) 2021
+//
+// The software is supplied as is and for educational purposes
+// without any guarantees nor responsibility of its use in any application.
+//
+// ========================================================================
+
+
+#pragma once
+
+
+#include <cerrno>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+
+#include "BaseDefinitions.h"
+
+
+
+// On the POSIX host the files are mapped to the memory with mmap, so the pages are read in only when touched.
+// Elsewhere (e.g. on the ESP32 with the SPIFFS) the whole file is read to a buffer on the heap.
+#if ! defined( ESP_PLATFORM ) && ( defined( __unix__ ) || defined( __APPLE__ ) )
+	#define FORTH_HAS_MMAP 1
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#else
+	#define FORTH_HAS_MMAP 0
+	#include <cstdio>
+	#include <new>
+#endif
+
+
+
+namespace BCForth
+{
+
+
+
+	// The files mapped to the memory - each one is known by its address, so it can be unmapped only once.
+	// The ior codes are the errno values (0 means OK).
+	class TMappedFiles
+	{
+
+	public:
+
+		enum class EMapMode { kReadOnly, kCopyOnWrite };		// the writes to the copy-on-write map never go to the file
+
+		struct MapResult
+		{
+			RawByte *		fAddr {};
+			size_type		fLen {};
+			int				fIor {};
+		};
+
+	private:
+
+#if FORTH_HAS_MMAP
+		std::unordered_map< const RawByte *, size_type >					fMappings;		// addr -> len
+#else
+		struct Buffer
+		{
+			std::unique_ptr< RawByte [] >	fData;
+			size_type						fLen {};
+		};
+
+		std::unordered_map< const RawByte *, Buffer >						fMappings;		// addr -> the buffer with the file
+#endif
+
+	public:
+
+		TMappedFiles( void ) = default;
+
+		TMappedFiles( const TMappedFiles & ) = delete;
+		TMappedFiles & operator = ( const TMappedFiles & ) = delete;
+
+		~TMappedFiles()
+		{
+#if FORTH_HAS_MMAP
+			for( const auto & [ addr, len ] : fMappings )
+				::munmap( const_cast< RawByte * >( addr ), len );
+#endif
+		}
+
+
+		// An empty file gives the 0 address and the 0 length, and nothing to unmap
+		[[nodiscard]] MapResult Map( const std::string & path, EMapMode mode )
+		{
+#if FORTH_HAS_MMAP
+			const int fd { ::open( path.c_str(), O_RDONLY ) };
+			if( fd < 0 )
+				return MapResult { .fIor = errno };
+
+			struct stat st {};
+			if( ::fstat( fd, & st ) != 0 )
+			{
+				const int ior { errno };
+				::close( fd );
+				return MapResult { .fIor = ior };
+			}
+
+			const auto len { static_cast< size_type >( st.st_size ) };
+			if( len == 0 )
+			{
+				::close( fd );
+				return MapResult {};
+			}
+
+			const int prot { mode == EMapMode::kReadOnly ? PROT_READ : PROT_READ | PROT_WRITE };
+			void * addr { ::mmap( nullptr, len, prot, MAP_PRIVATE, fd, 0 ) };
+			const int ior { errno };
+			::close( fd );			// the map stays valid without the descriptor
+			if( addr == MAP_FAILED )
+				return MapResult { .fIor = ior };
+
+			auto * p { static_cast< RawByte * >( addr ) };
+			fMappings.emplace( p, len );
+			return MapResult { p, len, 0 };
+#else
+			( void ) mode;			// the buffer can always be written, but it is never written back to the file
+
+			std::unique_ptr< std::FILE, decltype( & std::fclose ) >		file( std::fopen( path.c_str(), "rb" ), & std::fclose );
+			if( ! file )
+				return MapResult { .fIor = errno != 0 ? errno : ENOENT };
+
+			if( std::fseek( file.get(), 0, SEEK_END ) != 0 )
+				return MapResult { .fIor = EIO };
+			const long end { std::ftell( file.get() ) };
+			if( end < 0 || std::fseek( file.get(), 0, SEEK_SET ) != 0 )
+				return MapResult { .fIor = EIO };
+
+			const auto len { static_cast< size_type >( end ) };
+			if( len == 0 )
+				return MapResult {};
+
+			std::unique_ptr< RawByte [] >	buf( new ( std::nothrow ) RawByte [ len ] );
+			if( ! buf )
+				return MapResult { .fIor = ENOMEM };
+			if( std::fread( buf.get(), 1, len, file.get() ) != len )
+				return MapResult { .fIor = EIO };
+
+			auto * p { buf.get() };
+			fMappings.emplace( p, Buffer { std::move( buf ), len } );
+			return MapResult { p, len, 0 };
+#endif
+		}
+
+
+		// The addr and len have to be the ones returned by Map
+		[[nodiscard]] int Unmap( const RawByte * addr, size_type len )
+		{
+			if( addr == nullptr && len == 0 )
+				return 0;			// an empty file
+
+			const auto pos { fMappings.find( addr ) };
+#if FORTH_HAS_MMAP
+			if( pos == fMappings.end() || pos->second != len )
+				return EINVAL;
+			if( ::munmap( const_cast< RawByte * >( addr ), len ) != 0 )
+				return errno;
+#else
+			if( pos == fMappings.end() || pos->second.fLen != len )
+				return EINVAL;
+#endif
+			fMappings.erase( pos );
+			return 0;
+		}
+
+	};
+
+
+
+}	// The end of the BCForth namespace
+
+
@@ -0,0 +1,93 @@
+// ========================================================================
+//
+// The Forth interpreter-compiler by Prof. Boguslaw Cyganek (C) 2021
+//
+// The software is supplied as is and for educational purposes
+// without any guarantees nor responsibility of its use in any application.
+//
+// ========================================================================
+
+
+#pragma once
+
+
+#include <array>
+#include <cstring>
+#include <algorithm>
+
+
+#include "BaseDefinitions.h"
+
+
+
+namespace BCForth
+{
+
+
+
+	// From this length of the pattern, the search skips with the Horspool's table
+	constexpr size_type kHorspoolMinPattern { 8 };
+
+
+
+	// The short patterns - memchr finds the candidates for the first byte, memcmp checks the rest.
+	// memchr goes through many bytes at once (it is vectorized in the C libraries), so only the candidates are checked.
+	[[nodiscard]] inline const RawByte * FindBytesByFirst( const RawByte * text, size_type n, const RawByte * pat, size_type m )
+	{
+		const RawByte * const last { text + n - m };		// the last place the pattern can start
+		for( const RawByte * p { text }; p <= last; ++ p )
+		{
+			p = static_cast< const RawByte * >( std::memchr( p, pat[ 0 ], static_cast< size_t >( last - p + 1 ) ) );
+			if( p == nullptr )
+				return nullptr;
+			if( std::memcmp( p + 1, pat + 1, m - 1 ) == 0 )
+				return p;
+		}
+		return nullptr;
+	}
+
+
+	// The longer patterns - the Boyer-Moore-Horspool search, which for the byte at the end of the window
+	// skips as far as that byte allows (the whole pattern if the byte is not in it)
+	[[nodiscard]] inline const RawByte * FindBytesHorspool( const RawByte * text, size_type n, const RawByte * pat, size_type m )
+	{
+		std::array< size_type, 256 >	skip;
+		skip.fill( m );
+		for( size_type i {}; i < m - 1; ++ i )
+			skip[ pat[ i ] ] = m - 1 - i;
+
+		const RawByte last_pat { pat[ m - 1 ] };
+		for( size_type pos {}; pos <= n - m; pos += skip[ text[ pos + m - 1 ] ] )
+			if( text[ pos + m - 1 ] == last_pat && std::memcmp( text + pos, pat, m - 1 ) == 0 )
+				return text + pos;
+
+		return nullptr;
+	}
+
+
+	// Returns the first occurrence of the pattern (pat,m) in the text (text,n), or nullptr if there is none.
+	// The empty pattern is at the beginning of the text.
+	[[nodiscard]] inline const RawByte * FindBytes( const RawByte * text, size_type n, const RawByte * pat, size_type m )
+	{
+		if( m == 0 )
+			return text;
+		if( m > n )
+			return nullptr;
+		if( m == 1 )
+			return static_cast< const RawByte * >( std::memchr( text, pat[ 0 ], n ) );
+
+		return m < kHorspoolMinPattern ? FindBytesByFirst( text, n, pat, m ) : FindBytesHorspool( text, n, pat, m );
+	}
+
+
+	// Returns the first byte which is not c, or text + n if all of them are c
+	[[nodiscard]] inline const RawByte * SkipBytes( const RawByte * text, size_type n, RawByte c )
+	{
+		return std::find_if( text, text + n, [ c ] ( const RawByte b ) { return b != c; } );
+	}
+
+
+
+}	// The end of the BCForth namespace
+
+
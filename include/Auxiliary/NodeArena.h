@@ -0,0 +1,163 @@
+// ========================================================================
+//
+// The Forth interpreter-compiler by Prof. Boguslaw Cyganek (C) 2021
+//
+// The software is supplied as is and for educational purposes
+// without any guarantees nor responsibility of its use in any application.
+//
+// ========================================================================
+
+
+#pragma once
+
+
+#include <new>
+#include <memory>
+#include <vector>
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+
+
+#include "BaseDefinitions.h"
+
+
+
+namespace BCForth
+{
+
+
+
+	// The size of a memory chunk of the node arena (in bytes)
+	constexpr size_type kNodeArenaChunkSize { 4 * 1024 };
+
+	// The bigger objects do not go to the arena
+	constexpr size_type kNodeArenaMaxObjectSize { 256 };
+
+
+
+	// The bump allocator for the word nodes (TWord objects), such as the compiled-in numerals, IF, DO, etc.
+	// The new nodes are placed one after the other in the memory chunks, with no allocator overhead for each of them.
+	// This also keeps the heap of small systems, such as the ESP32, from getting fragmented.
+	//
+	// A released node (e.g. after FORGET) goes to the free list of its size class, to be reused
+	// by the next node of that size. So the nodes of one definition are next to each other only
+	// as long as nothing has been released - later definitions fill the holes wherever they are.
+	// The chunks are kept for the whole run.
+	//
+	// There is one arena in the process, shared by all the TForth objects (see GetNodeArena).
+	// It is not synchronized, so the Forth objects cannot create or destroy their words in different threads.
+	class TNodeArena
+	{
+	public:
+
+		static constexpr size_type kAlignment { __STDCPP_DEFAULT_NEW_ALIGNMENT__ };		// as for ::operator new - the over-aligned objects do not go here
+
+	private:
+
+		static constexpr size_type kNumOfSizeClasses { kNodeArenaMaxObjectSize / kAlignment };
+
+		struct FreeBlock
+		{
+			FreeBlock *	fNext {};
+		};
+
+		using Chunk = std::unique_ptr< std::byte [] >;
+
+		std::vector< Chunk >	fChunks;
+
+		std::byte *				fFreePos {};		// the free space in the last chunk
+		size_type				fFreeBytes {};
+
+		std::array< FreeBlock *, kNumOfSizeClasses >	fFreeLists {};		// the released blocks, for each size class
+
+		size_type				fBytesInUse {};
+
+	public:
+
+		TNodeArena( void ) = default;
+
+		TNodeArena( const TNodeArena & ) = delete;
+		TNodeArena & operator = ( const TNodeArena & ) = delete;
+
+	private:
+
+		static constexpr size_type RoundUp( size_type size ) { return ( size + kAlignment - 1 ) / kAlignment * kAlignment; }
+
+		static constexpr size_type SizeClass( size_type rounded_size ) { return rounded_size / kAlignment - 1; }
+
+	public:
+
+		void * Allocate( size_type size )
+		{
+			const auto rounded_size { RoundUp( size > 0 ? size : 1 ) };
+
+			if( rounded_size > kNodeArenaMaxObjectSize )
+			{
+				if( void * p { std::malloc( size ) } )		// not ::operator new, which would not match the sized delete of the words
+					return p;
+				throw std::bad_alloc();
+			}
+
+			fBytesInUse += rounded_size;
+
+			if( auto & free_list = fFreeLists[ SizeClass( rounded_size ) ]; free_list != nullptr )
+			{
+				auto * block { free_list };
+				free_list = block->fNext;
+				return block;
+			}
+
+			if( rounded_size > fFreeBytes )
+			{
+				fChunks.emplace_back( new std::byte [ kNodeArenaChunkSize ] );		// the rest of the previous chunk is lost
+				fFreePos = fChunks.back().get();
+				fFreeBytes = kNodeArenaChunkSize;
+			}
+
+			auto * block { fFreePos };
+			fFreePos += rounded_size;
+			fFreeBytes -= rounded_size;
+			return block;
+		}
+
+		// The size has to be the same as for the Allocate()
+		void Deallocate( void * p, size_type size )
+		{
+			if( p == nullptr )
+				return;
+
+			const auto rounded_size { RoundUp( size > 0 ? size : 1 ) };
+
+			if( rounded_size > kNodeArenaMaxObjectSize )
+				return std::free( p );
+
+			fBytesInUse -= rounded_size;
+
+			auto & free_list = fFreeLists[ SizeClass( rounded_size ) ];
+			free_list = new ( p ) FreeBlock { free_list };
+		}
+
+	public:
+
+		[[nodiscard]] size_type GetBytesReserved( void ) const { return fChunks.size() * kNodeArenaChunkSize; }
+
+		[[nodiscard]] size_type GetBytesInUse( void ) const { return fBytesInUse; }
+
+	};
+
+
+
+	// All the word nodes of the process go to this arena, whichever TForth object they belong to.
+	// It is never destroyed, since a static Forth object can release its words after the other statics are gone.
+	inline TNodeArena & GetNodeArena( void )
+	{
+		static TNodeArena & theNodeArena { * new TNodeArena };
+		return theNodeArena;
+	}
+
+
+
+}	// The end of the BCForth namespace
+
+
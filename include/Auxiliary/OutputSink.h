@@ -0,0 +1,210 @@
+// ========================================================================
+//
+// The Forth interpreter-compiler by Prof. Boguslaw Cyganek (C) 2021
+//
+// The software is supplied as is and for educational purposes
+// without any guarantees nor responsibility of its use in any application.
+//
+// ========================================================================
+
+
+#pragma once
+
+
+#include <iostream>
+#include <streambuf>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <charconv>
+#include <concepts>
+#include <type_traits>
+
+
+#include "BaseDefinitions.h"
+
+
+
+namespace BCForth
+{
+
+
+
+	// When the buffered output goes to the target stream
+	enum class EFlushPolicy
+	{
+		kOnNewLine,		// line buffered - the default for the interactive terminal
+		kOnThreshold	// only when the buffer gets full, or on explicit Flush(), e.g. before KEY or a prompt
+	};
+
+
+	// The default size of the output buffer (in bytes)
+	constexpr size_type kOutSinkBufferSize { 4 * 1024 };
+
+
+
+	// The output sink used by all the output words, such as . EMIT TYPE ."
+	// It collects characters in an in-memory buffer and passes them to the target
+	// stream in chunks, rather than char-by-char with the iostream formatting machinery.
+	// The numbers are formatted with std::to_chars which does not depend on the stream's state.
+	//
+	// The sink is also a std::streambuf so the "old-style" formatted output,
+	// e.g. the one which uses std::setw, can go through the same buffer (see GetStream()),
+	// which keeps the order of all the printed characters.
+	class TOutputSink : public std::streambuf
+	{
+
+		std::ostream *			fTarget {};		// not owned
+
+		std::vector< char >		fBuffer;		// its capacity is set once and never exceeded
+
+		EFlushPolicy			fFlushPolicy { EFlushPolicy::kOnNewLine };
+
+		std::ostream			fStream { this };
+
+	public:
+
+		TOutputSink( std::ostream & target, EFlushPolicy fp = EFlushPolicy::kOnNewLine, size_type buf_size = kOutSinkBufferSize )
+			: fTarget( & target ), fFlushPolicy( fp )
+		{
+			fBuffer.reserve( buf_size > 0 ? buf_size : 1 );
+		}
+
+		~TOutputSink()
+		{
+			Flush();
+		}
+
+		TOutputSink( const TOutputSink & ) = delete;
+		TOutputSink & operator = ( const TOutputSink & ) = delete;
+
+	public:
+
+		// The stream view of this sink, for the iostream formatted output
+		[[nodiscard]] std::ostream & GetStream( void ) { return fStream; }
+
+		// Redirect the output, e.g. to a null stream to suppress it - the pending chars go to the old target
+		void SetTarget( std::ostream & target ) { Flush(); fTarget = & target; }
+
+		[[nodiscard]] EFlushPolicy GetFlushPolicy( void ) const { return fFlushPolicy; }
+		void SetFlushPolicy( EFlushPolicy fp ) { fFlushPolicy = fp; }
+
+	public:
+
+		// Pass all the buffered characters to the target stream
+		void Flush( void )
+		{
+			if( fBuffer.size() > 0 )
+			{
+				fTarget->write( fBuffer.data(), static_cast< std::streamsize >( fBuffer.size() ) );
+				fBuffer.clear();
+			}
+			fTarget->flush();
+		}
+
+		void Put( char c )
+		{
+			if( fBuffer.size() == fBuffer.capacity() )
+				Flush();
+
+			fBuffer.push_back( c );
+
+			if( c == kCR[ 0 ] && fFlushPolicy == EFlushPolicy::kOnNewLine )
+				Flush();
+		}
+
+		void Write( std::string_view sv )
+		{
+			if( fBuffer.size() + sv.size() > fBuffer.capacity() )
+			{
+				Flush();
+
+				if( sv.size() >= fBuffer.capacity() )
+				{
+					fTarget->write( sv.data(), static_cast< std::streamsize >( sv.size() ) );		// too long to be buffered at all
+					return;
+				}
+			}
+
+			fBuffer.insert( fBuffer.end(), sv.begin(), sv.end() );
+
+			if( fFlushPolicy == EFlushPolicy::kOnNewLine && sv.find( kCR[ 0 ] ) != std::string_view::npos )
+				Flush();
+		}
+
+	public:
+
+		// Print an integer in the given base. As with std::showbase, the hex values have the 0x prefix,
+		// and the non-decimal values are displayed as unsigned.
+		template < std::integral I >
+		void PutInt( I val, int base = EIntCompBase::kDec )
+		{
+			std::array< char, 2 + 8 * sizeof( I ) + 1 > buf {};		// enough for the binary base, the prefix and the sign
+			char * first { buf.data() };
+			char * const last { buf.data() + buf.size() };
+
+			if( base == EIntCompBase::kDec )
+			{
+				first = std::to_chars( first, last, val ).ptr;
+			}
+			else
+			{
+				const auto u_val { static_cast< std::make_unsigned_t< I > >( val ) };
+				if( u_val != 0 && base == EIntCompBase::kHex )
+					* first ++ = '0', * first ++ = 'x';
+				else if( u_val != 0 && base == EIntCompBase::kOct )
+					* first ++ = '0';
+				first = std::to_chars( first, last, u_val, base ).ptr;
+			}
+
+			Write( std::string_view( buf.data(), static_cast< size_t >( first - buf.data() ) ) );
+		}
+
+		// Print a floating-point value the same way as the default std::ostream (i.e. %g)
+		void PutFloat( FloatType val )
+		{
+			constexpr int kDefaultPrecision { 6 };
+			std::array< char, 32 > buf {};
+			const auto [ ptr, ec ] = std::to_chars( buf.data(), buf.data() + buf.size(), val, std::chars_format::general, kDefaultPrecision );
+			Write( std::string_view( buf.data(), static_cast< size_t >( ptr - buf.data() ) ) );
+		}
+
+		// Print a value of any of the Forth's numeric types
+		template < typename T >
+		void PutVal( T val, int base = EIntCompBase::kDec )
+		{
+			if constexpr( std::is_floating_point_v< T > )
+				PutFloat( val );
+			else
+				PutInt( val, base );
+		}
+
+	protected:
+
+		// The std::streambuf interface - the stream always writes through Put() and Write()
+
+		int_type overflow( int_type c ) override
+		{
+			if( traits_type::eq_int_type( c, traits_type::eof() ) == false )
+				Put( traits_type::to_char_type( c ) );
+			return traits_type::not_eof( c );
+		}
+
+		std::streamsize xsputn( const char_type * s, std::streamsize n ) override
+		{
+			Write( std::string_view( s, static_cast< size_t >( n ) ) );
+			return n;
+		}
+
+		int sync( void ) override
+		{
+			Flush();
+			return 0;
+		}
+
+	};
+
+
+
+}	// The end of the BCForth namespace
+
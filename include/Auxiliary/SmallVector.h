@@ -0,0 +1,177 @@
+// ========================================================================
+//
+// The Forth interpreter-compiler by Prof. Boguslaw Cyganek (C) 2021
+//
+// The software is supplied as is and for educational purposes
+// without any guarantees nor responsibility of its use in any application.
+//
+// ========================================================================
+
+
+#pragma once
+
+
+#include <memory>
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+
+
+#include "BaseDefinitions.h"
+
+
+
+namespace BCForth
+{
+
+
+
+	// A vector with a small inline buffer. Up to N elements are stored inside the object,
+	// only the longer sequences go to the heap. After shrink_to_fit() the heap block
+	// has the exact size (or is released if the elements fit in the buffer).
+	// Only for the trivially copyable types, such as pointers.
+	template < typename T, size_type N >
+	requires std::is_trivially_copyable_v< T >
+	class TSmallVecFor
+	{
+		static_assert( N > 0 );
+
+	public:
+
+		using value_type		= T;
+		using iterator			= T *;
+		using const_iterator	= const T *;
+
+	private:
+
+		T *				fData { fInline };		// either fInline or a heap block
+		std::uint32_t	fSize {};
+		std::uint32_t	fCapacity { N };
+
+		T				fInline[ N ] {};
+
+	private:
+
+		bool IsOnHeap( void ) const { return fData != fInline; }
+
+		void Reallocate( std::uint32_t new_cap )
+		{
+			assert( new_cap >= fSize );
+
+			T * new_data { new_cap > N ? new T [ new_cap ] : fInline };
+			if( new_data != fData )
+			{
+				std::copy_n( fData, fSize, new_data );
+				if( IsOnHeap() )
+					delete [] fData;
+			}
+
+			fData = new_data;
+			fCapacity = new_cap > N ? new_cap : N;
+		}
+
+	public:
+
+		TSmallVecFor( void ) = default;
+
+		TSmallVecFor( const TSmallVecFor & v ) { * this = v; }
+
+		TSmallVecFor( TSmallVecFor && v ) noexcept { * this = std::move( v ); }
+
+		~TSmallVecFor()
+		{
+			if( IsOnHeap() )
+				delete [] fData;
+		}
+
+		TSmallVecFor & operator = ( const TSmallVecFor & v )
+		{
+			if( this != & v )
+			{
+				clear();
+				if( v.fSize > fCapacity )
+					Reallocate( v.fSize );
+				std::copy_n( v.fData, v.fSize, fData );
+				fSize = v.fSize;
+			}
+			return * this;
+		}
+
+		TSmallVecFor & operator = ( TSmallVecFor && v ) noexcept
+		{
+			if( this != & v )
+			{
+				if( IsOnHeap() )
+					delete [] fData;
+
+				if( v.IsOnHeap() )
+				{
+					fData = v.fData;		// steal the heap block
+				}
+				else
+				{
+					fData = fInline;
+					std::copy_n( v.fData, v.fSize, fData );
+				}
+
+				fSize = v.fSize;
+				fCapacity = v.fCapacity;
+
+				v.fData = v.fInline;
+				v.fSize = 0;
+				v.fCapacity = N;
+			}
+			return * this;
+		}
+
+	public:
+
+		void push_back( const T & t )
+		{
+			if( fSize == fCapacity )
+				Reallocate( 2 * fCapacity );
+			fData[ fSize ++ ] = t;
+		}
+
+		void pop_back( void ) { assert( fSize > 0 ); -- fSize; }
+
+		void clear( void ) { fSize = 0; }
+
+		// Trim the heap block to the number of elements, or move them to the inline buffer
+		void shrink_to_fit( void )
+		{
+			if( IsOnHeap() && fSize < fCapacity )
+				Reallocate( fSize );
+		}
+
+	public:
+
+		[[nodiscard]] size_type	size( void ) const { return fSize; }
+		[[nodiscard]] size_type	capacity( void ) const { return fCapacity; }
+		[[nodiscard]] bool		empty( void ) const { return fSize == 0; }
+
+		// The heap memory held by this object
+		[[nodiscard]] size_type	heap_bytes( void ) const { return IsOnHeap() ? fCapacity * sizeof( T ) : 0; }
+
+		[[nodiscard]] T *			data( void )		{ return fData; }
+		[[nodiscard]] const T *	data( void ) const	{ return fData; }
+
+		[[nodiscard]] T &			operator [] ( size_type i )			{ assert( i < fSize ); return fData[ i ]; }
+		[[nodiscard]] const T &	operator [] ( size_type i ) const	{ assert( i < fSize ); return fData[ i ]; }
+
+		[[nodiscard]] T &			back( void )		{ assert( fSize > 0 ); return fData[ fSize - 1 ]; }
+		[[nodiscard]] const T &	back( void ) const	{ assert( fSize > 0 ); return fData[ fSize - 1 ]; }
+
+		[[nodiscard]] iterator			begin( void )		{ return fData; }
+		[[nodiscard]] iterator			end( void )			{ return fData + fSize; }
+		[[nodiscard]] const_iterator	begin( void ) const	{ return fData; }
+		[[nodiscard]] const_iterator	end( void ) const	{ return fData + fSize; }
+
+	};
+
+
+
+}	// The end of the BCForth namespace
+
+
@@ -0,0 +1,141 @@
+// ========================================================================
+//
+// The Forth interpreter-compiler by Prof. Boguslaw Cyganek (C) 2021
+//
+// The software is supplied as is and for educational purposes
+// without any guarantees nor responsibility of its use in any application.
+//
+// ========================================================================
+
+
+#pragma once
+
+
+#include <memory>
+#include <vector>
+#include <algorithm>
+
+
+#include "BaseDefinitions.h"
+
+
+
+namespace BCForth
+{
+
+
+
+	// The chunk of the transient arena - enough for the strings of a few lines
+#ifdef ESP_PLATFORM
+	constexpr size_type kTransientChunkSize { 1024 };
+#else
+	constexpr size_type kTransientChunkSize { 16 * 1024 };
+#endif
+
+
+
+	// The memory which lives only until the end of the interpreted line, e.g. for the strings of S" in the interpret mode.
+	// The allocation just moves a pointer, and the whole arena is freed at once with Reset(), so
+	// a REPL which gets thousands of lines does not grow. There is no partial freeing - the data can be
+	// left on the stack (e.g. by EVALUATE), so only the end of the whole line is safe.
+	//
+	// The first chunk stays for the next line, the others are freed.
+	class TTransientArena
+	{
+
+		struct Chunk
+		{
+			std::unique_ptr< RawByte [] >	fData;
+			size_type						fSize {};
+		};
+
+		std::vector< Chunk >	fChunks;
+
+		size_type				fUsed {};			// the bytes taken in the last chunk
+
+	public:
+
+		TTransientArena( void ) = default;
+
+		TTransientArena( const TTransientArena & ) = delete;
+		TTransientArena & operator = ( const TTransientArena & ) = delete;
+
+	public:
+
+		// n bytes, aligned to a cell, valid until Reset()
+		[[nodiscard]] RawByte * Allocate( size_type n )
+		{
+			constexpr size_type kAlignment { sizeof( CellType ) };
+			fUsed = ( fUsed + kAlignment - 1 ) & ~ ( kAlignment - 1 );
+
+			if( fChunks.empty() || fUsed + n > fChunks.back().fSize )
+			{
+				const auto size { std::max( n, kTransientChunkSize ) };		// a long string gets a chunk of its own
+				fChunks.emplace_back( Chunk { std::make_unique< RawByte [] >( size ), size } );
+				fUsed = 0;
+			}
+
+			auto * p { fChunks.back().fData.get() + fUsed };
+			fUsed += n;
+			return p;
+		}
+
+
+		// Frees all
+		void Reset( void )
+		{
+			const bool keep_first { fChunks.size() > 0 && fChunks.front().fSize == kTransientChunkSize };
+			fChunks.resize( keep_first ? 1 : 0 );
+			fUsed = 0;
+		}
+
+
+		[[nodiscard]] size_type GetBytesReserved( void ) const
+		{
+			size_type bytes {};
+			for( const auto & chunk : fChunks )
+				bytes += chunk.fSize;
+			return bytes;
+		}
+
+	};
+
+
+
+
+	// The scratch buffers, given one after another in a ring - the next kNumOfScratchBuffers - 1 ones
+	// do not touch the last one. So the words which need a temporary buffer (e.g. GET_TIME)
+	// do not overwrite each other, nor the PAD of the user.
+	constexpr size_type kNumOfScratchBuffers { 4 };
+
+#ifdef ESP_PLATFORM
+	constexpr size_type kScratchBufferSize { 256 };
+#else
+	constexpr size_type kScratchBufferSize { 1024 };
+#endif
+
+
+	class TScratchRing
+	{
+
+		std::unique_ptr< RawByte [] >	fData { std::make_unique< RawByte [] >( kNumOfScratchBuffers * kScratchBufferSize ) };
+
+		size_type						fNext {};
+
+	public:
+
+		// The next buffer of kScratchBufferSize bytes
+		[[nodiscard]] RawByte * Next( void )
+		{
+			auto * p { fData.get() + fNext * kScratchBufferSize };
+			fNext = ( fNext + 1 ) % kNumOfScratchBuffers;
+			return p;
+		}
+
+	};
+
+
+
+}	// The end of the BCForth namespace
+
+
@@ -0,0 +1,234 @@
+// ========================================================================
+//
+// The Forth interpreter-compiler by Prof. Boguslaw Cyganek (C) 2021
+//
+// The software is supplied as is and for educational purposes
+// without any guarantees nor responsibility of its use in any application.
+//
+// ========================================================================
+
+
+#pragma once
+
+
+#include <algorithm>
+#include <bit>
+
+
+#include "BaseDefinitions.h"
+
+
+
+// On the x86-64 host each kernel is compiled twice - for AVX2 and for the base instruction set -
+// and the right one is chosen at the program start, depending on the CPU.
+// Elsewhere (e.g. on the ESP32) there is only the scalar version.
+#if defined( __x86_64__ ) && defined( __GNUC__ ) && defined( __ELF__ )
+	#define FORTH_VEC_KERNEL	__attribute__(( target_clones( "avx2", "default" ) ))
+#else
+	#define FORTH_VEC_KERNEL
+#endif
+
+
+
+namespace BCForth
+{
+
+
+
+	// The kernels on the arrays of n elements, such as the cells or the floats of a CREATE or ARRAY buffer.
+	// They are simple loops which the compiler can vectorize. The output can be one of the inputs (in place).
+	// The integer arithmetic should go with the unsigned T, so the overflows wrap around (as for + and *).
+
+	// The number of partial sums in the reductions - so the floating-point additions
+	// do not wait for each other (the sum can differ in the last bits from the one added in order)
+	constexpr size_type kVecLanes { 4 };
+
+
+	template < typename T >
+	FORTH_VEC_KERNEL void VecAdd( const T * a, const T * b, T * c, size_type n )
+	{
+		for( size_type i {}; i < n; ++ i )
+			c[ i ] = a[ i ] + b[ i ];
+	}
+
+	template < typename T >
+	FORTH_VEC_KERNEL void VecSub( const T * a, const T * b, T * c, size_type n )
+	{
+		for( size_type i {}; i < n; ++ i )
+			c[ i ] = a[ i ] - b[ i ];
+	}
+
+	template < typename T >
+	FORTH_VEC_KERNEL void VecMul( const T * a, const T * b, T * c, size_type n )
+	{
+		for( size_type i {}; i < n; ++ i )
+			c[ i ] = a[ i ] * b[ i ];
+	}
+
+	template < typename T >
+	FORTH_VEC_KERNEL void VecScale( const T * a, T k, T * c, size_type n )
+	{
+		for( size_type i {}; i < n; ++ i )
+			c[ i ] = a[ i ] * k;
+	}
+
+
+	template < typename T >
+	FORTH_VEC_KERNEL T VecSum( const T * a, size_type n )
+	{
+		T acc[ kVecLanes ] {};
+		size_type i {};
+		for( ; i + kVecLanes <= n; i += kVecLanes )
+			for( size_type l {}; l < kVecLanes; ++ l )
+				acc[ l ] += a[ i + l ];
+
+		T sum {};
+		for( size_type l {}; l < kVecLanes; ++ l )
+			sum += acc[ l ];
+		for( ; i < n; ++ i )
+			sum += a[ i ];
+		return sum;
+	}
+
+	template < typename T >
+	FORTH_VEC_KERNEL T VecDot( const T * a, const T * b, size_type n )
+	{
+		T acc[ kVecLanes ] {};
+		size_type i {};
+		for( ; i + kVecLanes <= n; i += kVecLanes )
+			for( size_type l {}; l < kVecLanes; ++ l )
+				acc[ l ] += a[ i + l ] * b[ i + l ];
+
+		T sum {};
+		for( size_type l {}; l < kVecLanes; ++ l )
+			sum += acc[ l ];
+		for( ; i < n; ++ i )
+			sum += a[ i ] * b[ i ];
+		return sum;
+	}
+
+
+	// The index of the first smallest (or the greatest) element, n > 0
+	template < typename T, bool IsMax >
+	FORTH_VEC_KERNEL size_type VecExtremeIndex( const T * a, size_type n )
+	{
+		size_type best {};
+		for( size_type i { 1 }; i < n; ++ i )
+			if( IsMax ? a[ best ] < a[ i ] : a[ i ] < a[ best ] )
+				best = i;
+		return best;
+	}
+
+
+	template < typename T >
+	FORTH_VEC_KERNEL void VecClamp( T * a, size_type n, T lo, T hi )
+	{
+		for( size_type i {}; i < n; ++ i )
+			a[ i ] = a[ i ] < lo ? lo : hi < a[ i ] ? hi : a[ i ];
+	}
+
+
+	// c[ i ] = a[ 0 ] + ... + a[ i ]
+	template < typename T >
+	FORTH_VEC_KERNEL void VecPrefixSum( const T * a, T * c, size_type n )
+	{
+		T sum {};
+		for( size_type i {}; i < n; ++ i )
+			c[ i ] = sum += a[ i ];
+	}
+
+
+
+
+	// The matrices are row-major. The blocks of kMatBlock x kMatBlock elements
+	// of the three matrices fit in the L1 cache together (3 x 32 x 32 x 8 bytes = 24 kB).
+	constexpr size_type kMatBlock { 32 };
+
+
+	// c = a * b, where a is rows x inner, b is inner x cols, c is rows x cols (c cannot be a or b)
+	template < typename T >
+	FORTH_VEC_KERNEL void MatMul( const T * a, const T * b, T * c, size_type rows, size_type inner, size_type cols )
+	{
+		for( size_type i {}; i < rows * cols; ++ i )
+			c[ i ] = T {};
+
+		for( size_type ii {}; ii < rows; ii += kMatBlock )
+			for( size_type kk {}; kk < inner; kk += kMatBlock )
+				for( size_type jj {}; jj < cols; jj += kMatBlock )
+				{
+					const auto i_end { std::min( ii + kMatBlock, rows ) }, k_end { std::min( kk + kMatBlock, inner ) }, j_end { std::min( jj + kMatBlock, cols ) };
+					for( size_type i { ii }; i < i_end; ++ i )
+						for( size_type k { kk }; k < k_end; ++ k )
+						{
+							const T a_ik { a[ i * inner + k ] };
+							T * c_row { c + i * cols };
+							const T * b_row { b + k * cols };
+							for( size_type j { jj }; j < j_end; ++ j )		// along the rows of b and c, so this one is vectorized
+								c_row[ j ] += a_ik * b_row[ j ];
+						}
+				}
+	}
+
+
+	// b = the transposed a, where a is rows x cols (b cannot be a)
+	template < typename T >
+	FORTH_VEC_KERNEL void MatTranspose( const T * a, T * b, size_type rows, size_type cols )
+	{
+		for( size_type ii {}; ii < rows; ii += kMatBlock )
+			for( size_type jj {}; jj < cols; jj += kMatBlock )
+			{
+				const auto i_end { std::min( ii + kMatBlock, rows ) }, j_end { std::min( jj + kMatBlock, cols ) };
+				for( size_type i { ii }; i < i_end; ++ i )
+					for( size_type j { jj }; j < j_end; ++ j )
+						b[ j * rows + i ] = a[ i * cols + j ];
+			}
+	}
+
+
+
+
+	// The bit arrays - the bit i is in the word i / kBitsPerWord, at the position i % kBitsPerWord.
+	// The bits past the last one (in the last word) are kept 0.
+	constexpr size_type kBitsPerWord { 8 * sizeof( CellType ) };
+
+	[[nodiscard]] constexpr size_type NumOfBitWords( size_type num_of_bits ) { return ( num_of_bits + kBitsPerWord - 1 ) / kBitsPerWord; }
+
+
+	// The number of the set bits - std::popcount is one instruction where the CPU has it
+	FORTH_VEC_KERNEL inline size_type BitCount( const CellType * w, size_type num_of_words )
+	{
+		size_type cnt {};
+		for( size_type i {}; i < num_of_words; ++ i )
+			cnt += static_cast< size_type >( std::popcount( w[ i ] ) );
+		return cnt;
+	}
+
+	// The index of the first set bit from the bit from on, or num_of_bits if there is none
+	[[nodiscard]] inline size_type BitFindNext( const CellType * w, size_type num_of_bits, size_type from )
+	{
+		if( from >= num_of_bits )
+			return num_of_bits;
+
+		const auto num_of_words { NumOfBitWords( num_of_bits ) };
+		auto wi { from / kBitsPerWord };
+		for( auto cur { w[ wi ] & ( ~ CellType {} << ( from % kBitsPerWord ) ) }; ; cur = w[ wi ] )
+		{
+			if( cur != 0 )
+				return std::min( wi * kBitsPerWord + static_cast< size_type >( std::countr_zero( cur ) ), num_of_bits );
+			if( ++ wi == num_of_words )
+				return num_of_bits;
+		}
+	}
+
+	// Clears the bits first, first + step, first + 2 * step, ... (step > 0), e.g. the multiples in the sieve
+	inline void BitClearStep( CellType * w, size_type num_of_bits, size_type first, size_type step )
+	{
+		for( auto i { first }; i < num_of_bits; i += step )
+			w[ i / kBitsPerWord ] &= ~ ( CellType { 1 } << ( i % kBitsPerWord ) );
+	}
+
+
+
+}	// The end of the BCForth namespace
+
+
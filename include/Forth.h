@@ -1,196 +1,581 @@
-// ========================================================================
-//
-// The Forth interpreter-compiler by Prof. Boguslaw Cyganek (C) 2021
-//
-// The software is supplied as is and for educational purposes
-// without any guarantees nor responsibility of its use in any application. 
-//
-// ========================================================================
-
-
-#pragma once
-
-
-#include <iostream>
-#include <iomanip>
-#include <string>
-#include <vector>
-#include <unordered_map>
-#include <sstream>
-#include <string>
-#include <algorithm>
-#include <concepts>
-#include <optional>
-#include <tuple>
-#include <iterator>
-#include <functional>
-#include <fstream>
-
-
-#include "Words.h"
-
-
-
-
-
-
-
-
-namespace BCForth
-{
-
-
-
-
-
-	// Space for the basic Forth's data structures
-	class TForth
-	{
-	public:
-
-		virtual ~TForth() = default;
-
-	public:
-
-		static const size_t kStackMaxCells { 64 };	// change for low memory systems
-
-		using DataStack = ForthStackFor< CellType, kStackMaxCells >;
-
-		using RetStack = TStackFor< CellType, kStackMaxCells >;
-
-
-	public:
-
-		[[nodiscard]] DataStack &	GetDataStack( void ) { return fDataStack; }			
-
-		[[nodiscard]] RetStack &	GetRetStack( void ) { return fRetStack; }	
-
-
-	public:
-
-		using WordPtr = TWord< TForth > *;
-
-		using WordUP = std::unique_ptr< TWord< TForth > >;
-
-	protected: 
-
-		// The main record to store all information about each word in the system
-		// These are held in the fWordDict
-		struct WordEntry
-		{
-			WordUP	fWordUP;
-			bool	fWordIsCompiled		: 1		{ false };		// set if a word is currently compiled 
-			bool	fWordIsImmediate		: 1		{ false };		// set if a word is immediate (executed during compilation of other words)
-			bool	fWordIsDefining		: 1		{ false };		// set if a word contains DOES> in its definition
-			Name	fWordComment;											// commenting text of this word
-			// reserved for further data
-
-			DebugFileInfo			fDebugFileInfo;					// a field only in the debug version, stores info on token position in the source file
-		};
-
-		using WordOptional = std::optional< WordEntry * >;
-
-
-		using WordDict = std::unordered_map< Name, WordEntry >;		// for low memory systems change to std::map
-
-
-
-	protected:
-
-
-		DataStack		fDataStack;			// the main Forth's data structure
-
-		RetStack			fRetStack;			// the second stack, called a "return" stack in Forth frameworks
-													// (not used, left only for user's convenience)
-
-		WordDict			fWordDict;			// a dictionary with all Forth's words
-
-
-	protected:
-
-
-		using NodeRepo = std::vector< WordUP >;
-
-		NodeRepo fNodeRepo;		// stores all word nodes that do not go to the dictionary, such as compiled in numerals, etc.
-
-
-	public:
-
-		WordPtr Insert_2_NodeRepo( WordUP wp )
-		{
-			auto wptr { wp.get() };
-			fNodeRepo.push_back( std::move( wp ) );
-			return wptr;
-		}
-
-
-		const NodeRepo & GetNodeRepo( void ) const { return fNodeRepo; }
-
-	public:
-
-		WordDict &	GetWordDict( void ) { return fWordDict; }
-
-
-		// Returns a non-owning ptr to the just inserted word
-		WordPtr InsertWord_2_Dict( const Name & name, WordUP wp, Name comment_str = "", bool compiled = false, bool immediate = false, bool defining = false, DebugFileInfo dif = DebugFileInfo() )
-		{
-			WordPtr retPtr { wp.get() };
-
-			if constexpr( FORTH_IS_CASE_INSENSITIVE )
-				fWordDict[ ToUpper( name ) ] = WordEntry { std::move( wp ), compiled, immediate, defining, comment_str, dif };
-
-			else
-				fWordDict[ name ] = WordEntry { std::move( wp ), compiled, immediate, defining, comment_str, dif };
-				
-			return retPtr;
-		}
-
-	public:
-
-		// Get the word's entry but the word can be not present
-		[[nodiscard]] auto GetWordEntry( const Name & word_name )
-		{
-
-			if constexpr( FORTH_IS_CASE_INSENSITIVE )
-
-				if( const auto & word = fWordDict.find( ToUpper( word_name ) ); word != fWordDict.end() )
-					return WordOptional( & word->second );
-				else
-					return WordOptional();
-
-			else
-
-				if( const auto & word = fWordDict.find( word_name ); word != fWordDict.end() )
-					return WordOptional( & word->second );
-				else
-					return WordOptional();
-		}
-
-
-
-		// Returns true if a word was found and executed
-		virtual bool ExecWord( const Name & word_name )
-		{
-			auto word = GetWordEntry( word_name );
-			return word ? ( * ( (*word)->fWordUP ) )(), true : false;
-		}
-
-
-		virtual EIntCompBase ReadTheBase( void )
-		{
-			return EIntCompBase::kDec;		// in the base only this, will be extended in the interpreter
-		}
-
-
-	};
-
-
-
-
-}	// The end of the BCForth namespace
-
-
-
-
-
-
+// ========================================================================
+//
+// The Forth interpreter-compiler by Prof. Boguslaw Cyganek (C) 2021
+//
+// The software is supplied as is and for educational purposes
+// without any guarantees nor responsibility of its use in any application. 
+//
+// ========================================================================
+
+
+#pragma once
+
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <deque>
+#include <sstream>
+#include <string>
+#include <algorithm>
+#include <concepts>
+#include <optional>
+#include <variant>
+#include <tuple>
+#include <iterator>
+#include <functional>
+#include <fstream>
+
+
+#include "Words.h"
+#include "FrozenWordTable.h"
+#include "DataSpace.h"
+#include "TransientArena.h"
+
+
+
+
+
+
+
+
+namespace BCForth
+{
+
+
+
+
+
+	// The settings of each Forth instance
+	struct ForthConfig
+	{
+		size_type	fDataStackCells { 64 };			// change for low memory systems
+		size_type	fMaxDataStackCells { 0 };		// if greater than fDataStackCells, then the data stack can grow up to this size
+		size_type	fRetStackCells { 64 };
+		size_type	fFloatStackCells { 32 };
+		size_type	fDataSpaceBytes { kDataSpaceSize };
+	};
+
+
+
+	// Space for the basic Forth's data structures
+	class TForth
+	{
+	public:
+
+		explicit TForth( const ForthConfig & config = ForthConfig() )
+			: fDataStack( config.fDataStackCells, config.fMaxDataStackCells ), fRetStack( config.fRetStackCells ), fFloatStack( config.fFloatStackCells ), fDataSpace( config.fDataSpaceBytes )
+		{}
+
+		virtual ~TForth() = default;
+
+	public:
+
+		using DataStack = ForthDynStackFor< CellType, kStackCheck >;
+
+		using RetStack = TDynStackFor< CellType >;
+
+		using FloatStack = ForthDynStackFor< FloatType, kStackCheck >;
+
+
+	public:
+
+		[[nodiscard]] DataStack &	GetDataStack( void ) { return fDataStack; }			
+
+		[[nodiscard]] RetStack &	GetRetStack( void ) { return fRetStack; }	
+
+		[[nodiscard]] FloatStack &	GetFloatStack( void ) { return fFloatStack; }
+
+		[[nodiscard]] TDataSpace &	GetDataSpace( void ) { return fDataSpace; }
+
+		[[nodiscard]] TTransientArena &	GetTransientArena( void ) { return fTransientArena; }
+
+		[[nodiscard]] TScratchRing &	GetScratchRing( void ) { return fScratchRing; }
+
+
+		// Throws if any of the stack guard zones was overwritten (then restores them)
+		void CheckStackGuards( void )
+		{
+			if( fDataStack.CheckGuards() && fRetStack.CheckGuards() && fFloatStack.CheckGuards() )
+				return;
+
+			fDataStack.RestoreGuards(), fRetStack.RestoreGuards(), fFloatStack.RestoreGuards();
+			throw ForthError( "stack memory overwritten (guard zone)" );
+		}
+
+
+	public:
+
+		using WordPtr = TWord< TForth > *;
+
+		using WordUP = std::unique_ptr< TWord< TForth > >;
+
+	protected: 
+
+		// The main record to store all information about each word in the system
+		// These are held in the word lists. Only what is needed to find and to call a word is here - 
+		// the comment and the debug info go to the word meta store.
+		struct WordEntry
+		{
+			WordUP	fWordUP;
+			bool	fWordIsCompiled		: 1		{ false };		// set if a word is currently compiled 
+			bool	fWordIsImmediate		: 1		{ false };		// set if a word is immediate (executed during compilation of other words)
+			bool	fWordIsDefining		: 1		{ false };		// set if a word contains DOES> in its definition
+			// reserved for further data
+		};
+
+		using WordOptional = std::optional< WordEntry * >;
+
+
+		// The names are stored in the canonical (upper) case, but the lookup is case-insensitive and takes std::string_view
+		using WordDict = std::unordered_map< Name, WordEntry, WordNameHash, WordNameEqual >;
+
+	public:
+
+		// A word list (a vocabulary) is identified by its index
+		using WordListId = CellType;
+
+		static constexpr WordListId	kForthWordList { 0 };		// the one with all the built-in words
+
+		static constexpr size_type	kMaxSearchOrder { 16 };		// the max number of word lists searched at once
+
+
+
+	protected:
+
+
+		DataStack		fDataStack;			// the main Forth's data structure
+
+		RetStack			fRetStack;			// the second stack, called a "return" stack in Forth frameworks
+													// (not used, left only for user's convenience)
+
+		FloatStack		fFloatStack;		// the floating-point values go here, in their native format
+
+		TDataSpace		fDataSpace;			// HERE, ALLOT, , (comma) - the data of the CREATEd words
+
+		TTransientArena	fTransientArena;	// the data of the current line only, e.g. the strings of S" in the interpret mode
+
+		TScratchRing	fScratchRing;		// the temporary buffers of the words, so they do not need the PAD
+
+		// The dictionary is a set of word lists, each with its own hash table.
+		// The std::deque never moves its elements, so the word lists stay put when a new one is added.
+		std::deque< WordDict >			fWordLists { 1 };		// the FORTH word list is always there
+
+		std::vector< WordListId >		fSearchOrder { kForthWordList };		// the word lists to search, the first one goes first
+
+		WordListId						fCurrentWordList { kForthWordList };	// the word list to which the new definitions go
+
+
+		// After FreezeDictionary(), each word list has also its perfect hash table (the word lists created later have none).
+		// The words entered after the freeze are found in the word lists.
+		using FrozenWordTable = TFrozenWordTableFor< WordDict >;
+
+		std::deque< FrozenWordTable >	fFrozenWordLists;
+
+
+		// The reverse index - from a word object to its dictionary entry (its name and WordEntry), in any word list.
+		// The pointers to the std::unordered_map elements stay valid also after rehashing.
+		using WordAddrIndex = std::unordered_map< const TWord< TForth > *, WordDict::value_type * >;
+
+		WordAddrIndex		fWordAddrIndex;
+
+
+		// The "cold" data of the words, used only by WORDS, FIND and the debugger.
+		// The comments of the built-in words are only viewed, since they are string literals (which stay in flash on the ESP32);
+		// the comments collected by the compiler are owned.
+		struct WordMeta
+		{
+			std::variant< std::string_view, Name >		fWordComment;
+			DebugFileInfo								fDebugFileInfo;		// a field only in the debug version, stores info on token position in the source file
+		};
+
+		using WordMetaStore = std::unordered_map< const TWord< TForth > *, WordMeta >;
+
+		WordMetaStore		fWordMetaStore;
+
+
+	protected:
+
+
+		using NodeRepo = std::vector< WordUP >;
+
+		NodeRepo fNodeRepo;		// stores all word nodes that do not go to the dictionary, such as compiled in numerals, etc.
+
+
+	public:
+
+		WordPtr Insert_2_NodeRepo( WordUP wp )
+		{
+			auto wptr { wp.get() };
+			fNodeRepo.push_back( std::move( wp ) );
+			return wptr;
+		}
+
+
+		const NodeRepo & GetNodeRepo( void ) const { return fNodeRepo; }
+
+
+	protected:
+
+		// Each change to the dictionary is recorded, so it can be rolled back with MARKER or FORGET.
+		// A redefined word is not destroyed, since other words can still call it - it is kept in the record.
+		struct DictJournalRecord
+		{
+			WordListId						fWordList {};
+			Name							fName;
+			std::optional< WordEntry >		fPrevEntry;			// the entry replaced by this one, if any
+			size_type						fNodeRepoSize {};	// the size of fNodeRepo when this entry was made
+			size_type						fDataSpaceHere {};	// the HERE offset before the data of this entry
+		};
+
+		std::vector< DictJournalRecord >	fDictJournal;
+
+		size_type							fForgetFenceNodeRepoSize {};	// nothing below the fence can be forgotten
+
+		NodeRepo							fForgottenWords;	// removed by a roll-back, released at a safe point (a word can forget itself)
+
+	public:
+
+		// The state of the dictionary to roll back to
+		struct DictCheckpoint
+		{
+			size_type						fJournalSize {};
+			size_type						fNodeRepoSize {};
+			size_type						fNumOfWordLists {};
+			WordListId						fCurrentWordList {};
+			std::vector< WordListId >		fSearchOrder;
+			size_type						fDataSpaceHere {};
+		};
+
+		[[nodiscard]] DictCheckpoint GetDictCheckpoint( void ) const
+		{
+			return DictCheckpoint { fDictJournal.size(), fNodeRepo.size(), fWordLists.size(), fCurrentWordList, fSearchOrder, fDataSpace.GetHereOffset() };
+		}
+
+
+		// Everything that is already in the dictionary cannot be forgotten later (usually called after loading the system modules).
+		// The journal is no longer needed then, but the redefined words must stay alive.
+		void SetForgetFence( void )
+		{
+			for( auto & rec : fDictJournal )
+				if( rec.fPrevEntry )
+					fNodeRepo.push_back( std::move( rec.fPrevEntry->fWordUP ) );
+
+			fDictJournal.clear();
+			fForgetFenceNodeRepoSize = fNodeRepo.size();
+		}
+
+
+		// Removes all the words defined after the checkpoint, restores the words they replaced,
+		// and frees their nodes. Takes time proportional to the number of removed definitions.
+		void RollBackDictionary( const DictCheckpoint & cp )
+		{
+			if( cp.fJournalSize > fDictJournal.size() || cp.fNodeRepoSize < fForgetFenceNodeRepoSize )
+				throw ForthError( "cannot roll back the dictionary past the fence" );
+
+			while( fDictJournal.size() > cp.fJournalSize )
+			{
+				auto & rec = fDictJournal.back();
+				auto & word_list = fWordLists[ rec.fWordList ];
+				const auto pos = word_list.find( rec.fName );
+				assert( pos != word_list.end() );
+
+				fWordAddrIndex.erase( pos->second.fWordUP.get() );
+				fForgottenWords.push_back( std::move( pos->second.fWordUP ) );
+
+				if( rec.fPrevEntry )
+				{
+					pos->second = std::move( * rec.fPrevEntry );		// the previous definition is visible again
+					fWordAddrIndex[ pos->second.fWordUP.get() ] = & * pos;
+				}
+				else
+				{
+					if( rec.fWordList < fFrozenWordLists.size() )
+						fFrozenWordLists[ rec.fWordList ].WordErased( & * pos );
+					word_list.erase( pos );
+				}
+
+				fDictJournal.pop_back();
+			}
+
+			for( ; fNodeRepo.size() > cp.fNodeRepoSize; fNodeRepo.pop_back() )
+				fForgottenWords.push_back( std::move( fNodeRepo.back() ) );
+
+			fDataSpace.SetHereOffset( cp.fDataSpaceHere );
+
+			if( cp.fNumOfWordLists > 0 )
+				while( fWordLists.size() > cp.fNumOfWordLists )
+					fWordLists.pop_back();		// all their words were entered after the checkpoint, so they are empty now
+
+			if( fFrozenWordLists.size() > fWordLists.size() )
+				fFrozenWordLists.resize( fWordLists.size() );
+
+			fCurrentWordList = cp.fCurrentWordList < fWordLists.size() ? cp.fCurrentWordList : kForthWordList;
+
+			fSearchOrder.clear();
+			std::ranges::copy_if( cp.fSearchOrder, std::back_inserter( fSearchOrder ), [ this ] ( auto wid ) { return wid < fWordLists.size(); } );
+		}
+
+
+		// Removes the word from the current word list, and all the words defined after it
+		void ForgetWord( std::string_view word_name )
+		{
+			const auto rec_pos = std::find_if( fDictJournal.rbegin(), fDictJournal.rend(), 
+									[ this, word_name ] ( const auto & rec ) { return rec.fWordList == fCurrentWordList && WordNameEqual()( rec.fName, word_name ); } );
+			if( rec_pos == fDictJournal.rend() )
+				throw ForthError( "FORGET - the word was not found or is below the fence - " + Name( word_name ) );
+
+			const auto rec_idx { static_cast< size_type >( std::distance( rec_pos, fDictJournal.rend() ) - 1 ) };
+
+			RollBackDictionary( DictCheckpoint {	rec_idx, 
+													rec_idx > 0 ? fDictJournal[ rec_idx - 1 ].fNodeRepoSize : fForgetFenceNodeRepoSize,
+													0, fCurrentWordList, fSearchOrder, fDictJournal[ rec_idx ].fDataSpaceHere } );
+		}
+
+
+		// Called when no word is being executed
+		void ReleaseForgottenWords( void )
+		{
+			for( const auto & wp : fForgottenWords )
+				fWordMetaStore.erase( wp.get() );
+			fForgottenWords.clear();
+		}
+
+	public:
+
+		// The word list to which the new definitions go
+		WordDict &	GetWordDict( void ) { return fWordLists[ fCurrentWordList ]; }
+
+		WordDict &	GetWordList( WordListId wid ) { return fWordLists[ CheckWordListId( wid ) ]; }
+
+		[[nodiscard]] size_type	GetNumOfWordLists( void ) const { return fWordLists.size(); }
+
+
+		// Creates a new empty word list and returns its id
+		WordListId CreateWordList( void )
+		{
+			fWordLists.emplace_back();
+			return fWordLists.size() - 1;
+		}
+
+		[[nodiscard]] WordListId	GetCurrent( void ) const { return fCurrentWordList; }
+		void						SetCurrent( WordListId wid ) { fCurrentWordList = CheckWordListId( wid ); }
+
+		[[nodiscard]] const auto &	GetSearchOrder( void ) const { return fSearchOrder; }
+
+		void SetSearchOrder( std::vector< WordListId > search_order )
+		{
+			if( search_order.size() > kMaxSearchOrder )
+				throw ForthError( "search-order overflow" );
+
+			std::ranges::for_each( search_order, [ this ] ( auto wid ) { CheckWordListId( wid ); } );
+			fSearchOrder = std::move( search_order );
+		}
+
+	protected:
+
+		WordListId CheckWordListId( WordListId wid ) const
+		{
+			if( wid >= fWordLists.size() )
+				throw ForthError( "unknown word list" );
+			return wid;
+		}
+
+	public:
+
+
+		// Returns a non-owning ptr to the just inserted word
+		WordPtr InsertWord_2_Dict( const Name & name, WordUP wp, Name comment_str = "", bool compiled = false, bool immediate = false, bool defining = false, DebugFileInfo dif = DebugFileInfo() )
+		{
+			return InsertWordWithMeta( name, std::move( wp ), std::move( comment_str ), compiled, immediate, defining, dif );
+		}
+
+		// The same but the comment is a string literal, so only its view is stored
+		template < size_t N >
+		WordPtr InsertWord_2_Dict( const Name & name, WordUP wp, const char (& comment_str)[ N ], bool compiled = false, bool immediate = false, bool defining = false, DebugFileInfo dif = DebugFileInfo() )
+		{
+			return InsertWordWithMeta( name, std::move( wp ), std::string_view( comment_str ), compiled, immediate, defining, dif );
+		}
+
+	private:
+
+		WordPtr InsertWordWithMeta( const Name & name, WordUP wp, auto comment_str, bool compiled, bool immediate, bool defining, const DebugFileInfo & dif )
+		{
+			WordPtr retPtr { wp.get() };
+
+			if constexpr( FORTH_IS_CASE_INSENSITIVE )
+				EnterWordEntry( ToUpper( name ), WordEntry { std::move( wp ), compiled, immediate, defining } );
+
+			else
+				EnterWordEntry( name, WordEntry { std::move( wp ), compiled, immediate, defining } );
+
+			SetWordMeta( retPtr, std::move( comment_str ), dif );
+			return retPtr;
+		}
+
+	public:
+
+		// Comment is either Name or std::string_view
+		void SetWordMeta( const TWord< TForth > * p, auto comment_str, [[maybe_unused]] const DebugFileInfo & dif = DebugFileInfo() )
+		{
+			if constexpr( ! FORTH_KEEPS_WORD_COMMENTS )
+				comment_str = {};
+
+#if DEBUG_ON
+			if( comment_str.empty() && dif.fSourceFile_LnCol == LnCol {} && dif.fSourceFile_Index == SourceFileIndex {} )
+#else
+			if( comment_str.empty() )
+#endif
+			{
+				fWordMetaStore.erase( p );		// nothing to store
+				return;
+			}
+
+			fWordMetaStore[ p ] = WordMeta { std::move( comment_str ), dif };
+		}
+
+		[[nodiscard]] std::string_view GetWordComment( const TWord< TForth > * p ) const
+		{
+			if( const auto pos = fWordMetaStore.find( p ); pos != fWordMetaStore.end() )
+				return std::visit( [] ( const auto & c ) { return std::string_view( c ); }, pos->second.fWordComment );
+			else
+				return std::string_view();
+		}
+
+		[[nodiscard]] DebugFileInfo GetWordDebugFileInfo( const TWord< TForth > * p ) const
+		{
+			if( const auto pos = fWordMetaStore.find( p ); pos != fWordMetaStore.end() )
+				return pos->second.fDebugFileInfo;
+			else
+				return DebugFileInfo();
+		}
+
+	protected:
+
+		// All entries go to the current word list this way, to keep the reverse index and the journal up to date.
+		// An entry with the same name in that list is replaced (but is kept in the journal).
+		WordEntry & EnterWordEntry( const Name & name, WordEntry && entry )
+		{
+			auto [ pos, inserted ] = GetWordDict().try_emplace( name );
+
+			auto & rec = fDictJournal.emplace_back( DictJournalRecord { fCurrentWordList, name, std::nullopt, fNodeRepo.size(), fDataSpace.TakeDataFieldMark() } );
+			if( inserted )
+			{
+				if( fCurrentWordList < fFrozenWordLists.size() )
+					fFrozenWordLists[ fCurrentWordList ].NewWordEntered();
+			}
+			else
+			{
+				fWordAddrIndex.erase( pos->second.fWordUP.get() );
+				rec.fPrevEntry = std::move( pos->second );
+			}
+
+			pos->second = std::move( entry );
+			fWordAddrIndex[ pos->second.fWordUP.get() ] = & * pos;
+			return pos->second;
+		}
+
+	public:
+
+		// Get the word's entry but the word can be not present
+		// The word lists are searched in the search order
+		[[nodiscard]] auto GetWordEntry( std::string_view word_name )
+		{
+			for( const auto wid : fSearchOrder )
+				if( auto * word = FindInWordList( wid, word_name ) )
+					return WordOptional( & word->second );
+
+			return WordOptional();
+		}
+
+		// Get the word's entry only from the current word list (where the new definitions go)
+		[[nodiscard]] auto GetCurrentWordEntry( std::string_view word_name )
+		{
+			if( auto * word = FindInWordList( fCurrentWordList, word_name ) )
+				return WordOptional( & word->second );
+			else
+				return WordOptional();
+		}
+
+	protected:
+
+		// The frozen table goes first - if it is complete, then there is no need to look further
+		WordDict::value_type * FindInWordList( WordListId wid, std::string_view word_name )
+		{
+			if( wid < fFrozenWordLists.size() )
+			{
+				const auto & frozen = fFrozenWordLists[ wid ];
+				if( auto * word = frozen.Find( word_name ) )
+					return word;
+				if( frozen.IsComplete() )
+					return nullptr;
+			}
+
+			auto & word_list = fWordLists[ wid ];
+			const auto word = word_list.find( word_name );		// the case is folded by the hasher, no temporaries here
+			return word != word_list.end() ? & * word : nullptr;
+		}
+
+	public:
+
+		// Builds the perfect hash tables of all the word lists. Then a word is found in one probe,
+		// with no allocation. Can be called again, e.g. after loading more words.
+		void FreezeDictionary( void )
+		{
+			fFrozenWordLists.resize( fWordLists.size() );
+			for( WordListId wid {}; wid < fWordLists.size(); ++ wid )
+				fFrozenWordLists[ wid ].Build( fWordLists[ wid ] );
+		}
+
+		[[nodiscard]] bool IsDictionaryFrozen( void ) const { return fFrozenWordLists.size() > 0; }
+
+
+
+		// Find a dictionary entry and the name of a word from its address, in O(1).
+		// Only the words which are in the dictionary can be found (not e.g. the compiled-in numerals).
+		[[nodiscard]] auto GetWordEntryAndNameFromWordAddress( const TWord< TForth > * p )
+		{
+			if( const auto pos = fWordAddrIndex.find( p ); pos != fWordAddrIndex.end() )
+				return std::tuple( WordOptional( & pos->second->second ), std::string_view( pos->second->first ) );
+			else 
+				return std::tuple( WordOptional(), std::string_view() );
+		}
+
+		[[nodiscard]] std::string_view GetNameFromWordAddress( const TWord< TForth > * p ) const
+		{
+			if( const auto pos = fWordAddrIndex.find( p ); pos != fWordAddrIndex.end() )
+				return pos->second->first;
+			else 
+				return std::string_view();
+		}
+
+
+
+		// Returns true if a word was found and executed
+		virtual bool ExecWord( std::string_view word_name )
+		{
+			auto word = GetWordEntry( word_name );
+			return word ? ( * ( (*word)->fWordUP ) )(), true : false;
+		}
+
+
+		virtual EIntCompBase ReadTheBase( void )
+		{
+			return EIntCompBase::kDec;		// in the base only this, will be extended in the interpreter
+		}
+
+
+	};
+
+
+
+
+}	// The end of the BCForth namespace
+
+
+
+
+
+
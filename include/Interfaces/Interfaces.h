@@ -1,222 +1,374 @@
-// ========================================================================
-//
-// The Forth interpreter-compiler by Prof. Boguslaw Cyganek (C) 2021
-//
-// The software is supplied as is and for educational purposes
-// without any guarantees nor responsibility of its use in any application. 
-//
-// ========================================================================
-
-
-
-#pragma once
-
-
-
-
-#include <stdlib.h>
-
-#include "ForthCompiler.h"
-#include "Modules.h"
-#include "FP_Module.h"
-#include "StringModule.h"
-#include "CoreModule.h"
-#include "RandModule.h"
-#include "TimeModule.h"
-
-#include "FiberRoutines.h"
-
-
-
-
-
-
-
-
-namespace BCForth
-{
-
-	const Names kMenu_ExitWords		{ "BYE", "EXIT" };
-
-	const Name  kMenu_FileLoadWord	{ "LOAD" };
-
-	const Name  kMenu_Help			{ "HELP" };
-
-
-	// This is called before the Forth interpreter
-	// to check and take action on system words
-	bool SystemProcessTokens( TForthCompiler & , const /*Names*/TokenStream & , bool & );
-
-
-	const Name kWelcomeString { R"(==========================================
-Welcome to the Forth interpreter-compiler
-Written by Prof. Boguslaw Cyganek (C) 2023
-==========================================
-)" };
-
-
-	const Name kHelpString { R"(----------------------------------------------------------
-Load - loads & executes a text file
-Exit, bye - to leave		
-Words - prints a list of words in the dictionary
-All operations on the stack in the Reverse Polish Notation							
-----------------------------------------------------------)" };
-
-
-
-	void Run( void )
-	{
-		std::cout << kWelcomeString<<std::endl;
-		TForthReader theReader;
-
-		bool exit_flag { false };
-
-		TForthCompiler	F_compiler;
-		// /*TForthReader*/TForthReader_4_Debugging	theReader;
-
-
-
-		// This is "a must"
-		CoreEncodedWords()( F_compiler );
-		CoreDefinedWords()( F_compiler );
-
-
-		// Load extra modules - order matters (words depend on previous words)
-		AuxStackWords()( F_compiler );
-		FP_Module()( F_compiler );
-		AuxTextModule()( F_compiler );
-		StringModule()( F_compiler );
-		RandomModule()( F_compiler );
-		TimeModule()( F_compiler );
-		
-	
-
-
-		do
-		{
-			try 
-			{
-				//auto terminal_input_index { SourceFileIndex::GetUniqueFileId() };
-#if DEBUG_ON
-				//F_compiler.GetSourceFilesMap()[ terminal_input_index ] = "Terminal";
-				//TForthReader_4_Debugging	theReader( terminal_input_index );
-#else
-				TForthReader theReader;
-#endif
-				string tekst{};
-				std::cout<<"Waiting for command"<<std::endl;
-				while( ! exit_flag )
-				{
-					std::cout << "\nOK:" << std::endl;
-
-					auto tokens { theReader( std::cin ) };
-
-					if( SystemProcessTokens( F_compiler, tokens, exit_flag ) == false )
-						F_compiler( std::move( tokens ) );	
-				}
-			
-			}
-			catch( const ForthError & err )
-			{
-				F_compiler.CleanUpAfterRunTimeError( false );
-				std::cerr << "\nError: " << err.what() << endl;		// after this kind of errors we proceed	
-			}
-			catch( const std::exception & std_excpt )
-			{
-				std::cerr << "\nStandard error: " << std_excpt.what() << endl;		// after this kind of errors we proceed	
-			}
-			catch( ... )
-			{
-				std::cerr << "\nSystem error, exiting ... " << endl;
-				exit_flag = true;								// such error means finishing execution
-			}
-
-		}
-		while( exit_flag == false );
-
-
-	}
-
-
-
-	// ----------------------------
-
-
-
-	bool SystemProcessTokens( TForthCompiler & F_compiler, const TokenStream & ns, bool & exit_flag )
-	{
-		if( ns.size() == 0 )
-			return false;			// nothing to do, exiting
-
-		exit_flag = false;		// exit? not yet
-
-
-		Name str = ns[ 0 ].fName;		
-		if constexpr( FORTH_IS_CASE_INSENSITIVE )
-			str = ToUpper( ns[ 0 ].fName );
-
-
-		// -------------------------------------------------------------------------------
-		// Some special words have to break the "normal" operation of the Forth's compiler
-		if( std::find_if( kMenu_ExitWords.begin(), kMenu_ExitWords.end(), 
-			[ & str ] ( const auto & ex_word ) { return str.find( ex_word ) != Name::npos; } ) != kMenu_ExitWords.end() )
-		{
-			std::cerr << "\nBye, bye to you, exiting ... " << endl;
-			exit_flag = true;
-			return true;
-		}
-
-
-		// ---------------------------------------------------------
-		if( str.find( kMenu_FileLoadWord ) != Name::npos )
-		{
-
-			std::cout << "Enter path to the Forth code file [.txt]:\n";
-			if( std::string forth_source; std::cin >> forth_source )
-			{
-				if( std::ifstream fs( forth_source ); fs )
-				{
-#if DEBUG_ON
-					const auto file_index { SourceFileIndex::GetUniqueFileId() };
-					F_compiler.GetSourceFilesMap() [ file_index ] = forth_source;
-					for( TForthReader_4_Debugging fileReader( file_index ); fs; F_compiler( fileReader( fs ) ) ) 
-						;
-#else
-					for( TForthReader fileReader; fs; F_compiler( fileReader( fs ) ) ) 
-						;
-#endif
-
-					std::cout << "File processed OK\n" << endl;
-				}
-				else
-				{
-					std::cerr << "\nCannot open the file: " << forth_source << endl;		
-				}
-			}
-			else
-			{
-				std::cerr << "\nWrong file path: " << forth_source << endl;		
-			}
-
-			return true;	// load processed, no matter if the file could be or not properly opened
-		}
-
-		// ---------------------------------------
-		if( str.find( kMenu_Help ) != Name::npos )
-		{
-			std::cout << kHelpString << endl;
-			return true;
-		}
-
-	
-		return false;		// no system words, continue with the Forth interpreter
-	}
-
-
-	// ----------------------------
-
-
-}	// The end of the BCForth namespace
-
-
-
+// ========================================================================
+//
+// The Forth interpreter-compiler by Prof. Boguslaw Cyganek (C) 2021
+//
+// The software is supplied as is and for educational purposes
+// without any guarantees nor responsibility of its use in any application. 
+//
+// ========================================================================
+
+
+
+#pragma once
+
+
+
+
+#include <stdlib.h>
+#include <chrono>
+#include <fstream>
+
+#include "ForthCompiler.h"
+#include "Modules.h"
+#include "FP_Module.h"
+#include "StringModule.h"
+#include "FileModule.h"
+#include "VectorModule.h"
+#include "MatrixModule.h"
+#include "SortModule.h"
+#include "BitsModule.h"
+#include "CoreModule.h"
+#include "RandModule.h"
+#include "TimeModule.h"
+
+#include "FiberRoutines.h"
+
+
+
+
+
+
+
+
+namespace BCForth
+{
+
+	const Names kMenu_ExitWords		{ "BYE", "EXIT" };
+
+	const Name  kMenu_FileLoadWord	{ "LOAD" };
+
+	const Name  kMenu_Help			{ "HELP" };
+
+
+	// The name of the standard input in the list of the batch sources
+	const Name  kStdInSourceName	{ "-" };
+
+
+	// This is called before the Forth interpreter
+	// to check and take action on system words
+	bool SystemProcessTokens( TForthCompiler & , const /*Names*/TokenStream & , bool & );
+
+	// Loads all the standard modules into the compiler
+	void LoadModules( TForthCompiler & );
+
+	// Returns true if the token stream starts with one of the exit words
+	bool IsExitCommand( const TokenStream & );
+
+
+	const Name kWelcomeString { R"(==========================================
+Welcome to the Forth interpreter-compiler
+Written by Prof. Boguslaw Cyganek (C) 2023
+==========================================
+)" };
+
+
+	const Name kHelpString { R"(----------------------------------------------------------
+Load - loads & executes a text file
+Exit, bye - to leave		
+Words - prints a list of words in the dictionary
+All operations on the stack in the Reverse Polish Notation							
+----------------------------------------------------------)" };
+
+
+
+	void Run( void )
+	{
+		std::cout << kWelcomeString<<std::endl;
+		TForthReader theReader;
+
+		bool exit_flag { false };
+
+		TForthCompiler	F_compiler;
+		// /*TForthReader*/TForthReader_4_Debugging	theReader;
+
+		LoadModules( F_compiler );
+
+
+		do
+		{
+			try 
+			{
+				//auto terminal_input_index { SourceFileIndex::GetUniqueFileId() };
+#if DEBUG_ON
+				//F_compiler.GetSourceFilesMap()[ terminal_input_index ] = "Terminal";
+				//TForthReader_4_Debugging	theReader( terminal_input_index );
+#else
+				TForthReader theReader;
+#endif
+				string tekst{};
+				std::cout<<"Waiting for command"<<std::endl;
+				while( ! exit_flag )
+				{
+					F_compiler.GetOutSink().Flush();		// all the output must be visible before the prompt
+					std::cout << "\nOK:" << std::endl;
+
+					auto tokens { theReader( std::cin ) };
+
+					if( SystemProcessTokens( F_compiler, tokens, exit_flag ) == false )
+						F_compiler( std::move( tokens ) );	
+				}
+			
+			}
+			catch( const ForthError & err )
+			{
+				F_compiler.GetOutSink().Flush();
+				F_compiler.CleanUpAfterRunTimeError( false );
+				std::cerr << "\nError: " << err.what() << endl;		// after this kind of errors we proceed	
+			}
+			catch( const std::exception & std_excpt )
+			{
+				F_compiler.GetOutSink().Flush();
+				std::cerr << "\nStandard error: " << std_excpt.what() << endl;		// after this kind of errors we proceed	
+			}
+			catch( ... )
+			{
+				std::cerr << "\nSystem error, exiting ... " << endl;
+				exit_flag = true;								// such error means finishing execution
+			}
+
+		}
+		while( exit_flag == false );
+
+
+	}
+
+
+
+	// ----------------------------
+
+
+	// Options of the non-interactive (batch) mode
+	struct BatchOptions
+	{
+		bool	fSuppressOutput { false };		// discard everything that the Forth words print out
+		bool	fBufferOutput { false };		// pass the output only when the buffer gets full, instead of line by line
+		bool	fPrintTiming { false };			// print the processing time of each source (to std::cerr, so it does not mix with the output)
+		bool	fStopOnError { true };			// stop at the first error, otherwise skip the failing line and continue
+
+		ForthConfig		fForthConfig;			// e.g. the stack sizes
+	};
+
+
+	// Runs all sources one after another in the same Forth environment, with no prompts nor menus.
+	// The kStdInSourceName stands for the standard input (also if the list is empty).
+	// Returns EXIT_SUCCESS if all the sources were processed with no errors, EXIT_FAILURE otherwise.
+	int RunBatch( const Names & sources, const BatchOptions & options = BatchOptions() )
+	{
+		std::ostream	null_stream { nullptr };		// it has to outlive the compiler which flushes its output at the end
+
+		TForthCompiler	F_compiler { options.fForthConfig };
+
+		LoadModules( F_compiler );
+
+		auto & out_sink { F_compiler.GetOutSink() };
+		if( options.fSuppressOutput )
+			out_sink.SetTarget( null_stream );
+		if( options.fBufferOutput )
+			out_sink.SetFlushPolicy( EFlushPolicy::kOnThreshold );
+
+
+		int exit_status { EXIT_SUCCESS };
+		bool exit_flag { false };
+
+		using Clock = std::chrono::steady_clock;
+		const auto total_start { Clock::now() };
+
+		const Names std_in_only { kStdInSourceName };
+		for( const auto & source : sources.size() > 0 ? sources : std_in_only )
+		{
+			std::ifstream file_stream;
+			if( source != kStdInSourceName )
+			{
+				file_stream.open( source );
+				if( ! file_stream )
+				{
+					out_sink.Flush();
+					std::cerr << "Error: cannot open the file: " << source << endl;
+					exit_status = EXIT_FAILURE;
+
+					if( options.fStopOnError )
+						break;
+					continue;
+				}
+			}
+
+			std::istream & is { source != kStdInSourceName ? static_cast< std::istream & >( file_stream ) : std::cin };
+
+			const auto source_start { Clock::now() };
+
+#if DEBUG_ON
+			const auto file_index { SourceFileIndex::GetUniqueFileId() };
+			F_compiler.GetSourceFilesMap() [ file_index ] = source;
+			TForthReader_4_Debugging theReader( file_index );
+#else
+			TForthReader theReader;
+#endif
+
+			while( is && exit_flag == false )
+			{
+				try
+				{
+					if( auto tokens { theReader( is ) }; IsExitCommand( tokens ) )
+						exit_flag = true;
+					else
+						F_compiler( std::move( tokens ) );
+				}
+				catch( const ForthError & err )
+				{
+					out_sink.Flush();
+					F_compiler.CleanUpAfterRunTimeError( false );
+					std::cerr << "Error: " << source << ": " << err.what() << endl;
+					exit_status = EXIT_FAILURE;
+				}
+				catch( const std::exception & std_excpt )
+				{
+					out_sink.Flush();
+					std::cerr << "Standard error: " << source << ": " << std_excpt.what() << endl;
+					exit_status = EXIT_FAILURE;
+				}
+
+				if( exit_status != EXIT_SUCCESS && options.fStopOnError )
+					exit_flag = true;
+			}
+
+			if( options.fPrintTiming )
+			{
+				out_sink.Flush();
+				std::cerr << source << ": " << std::chrono::duration< double, std::milli >( Clock::now() - source_start ).count() << " ms" << endl;
+			}
+
+			if( exit_flag )
+				break;
+		}
+
+		out_sink.Flush();
+
+		if( options.fPrintTiming && sources.size() > 1 )
+			std::cerr << "Total: " << std::chrono::duration< double, std::milli >( Clock::now() - total_start ).count() << " ms" << endl;
+
+		return exit_status;
+	}
+
+
+
+	// ----------------------------
+
+
+	void LoadModules( TForthCompiler & F_compiler )
+	{
+		// This is "a must"
+		CoreEncodedWords()( F_compiler );
+		CoreDefinedWords()( F_compiler );
+
+
+		// Load extra modules - order matters (words depend on previous words)
+		AuxStackWords()( F_compiler );
+		FP_Module()( F_compiler );
+		AuxTextModule()( F_compiler );
+		StringModule()( F_compiler );
+		FileModule()( F_compiler );
+		VectorModule()( F_compiler );
+		MatrixModule()( F_compiler );
+		SortModule()( F_compiler );
+		BitsModule()( F_compiler );
+		RandomModule()( F_compiler );
+		TimeModule()( F_compiler );
+
+		F_compiler.SetForgetFence();		// the system words cannot be forgotten
+	}
+
+
+	bool IsExitCommand( const TokenStream & ns )
+	{
+		return	ns.size() > 0 
+				&& std::ranges::any_of( kMenu_ExitWords, [ & ns ] ( const auto & ex_word ) { return CheckMatch( ns[ 0 ].fName, ex_word ); } );
+	}
+
+
+
+	bool SystemProcessTokens( TForthCompiler & F_compiler, const TokenStream & ns, bool & exit_flag )
+	{
+		if( ns.size() == 0 )
+			return false;			// nothing to do, exiting
+
+		exit_flag = false;		// exit? not yet
+
+
+		// The system words must be the first token and match exactly, so they do not hijack e.g. a user's DOWNLOAD
+		const Name & str = ns[ 0 ].fName;
+
+
+		// -------------------------------------------------------------------------------
+		// Some special words have to break the "normal" operation of the Forth's compiler
+		if( IsExitCommand( ns ) )
+		{
+			std::cerr << "\nBye, bye to you, exiting ... " << endl;
+			exit_flag = true;
+			return true;
+		}
+
+
+		// ---------------------------------------------------------
+		if( CheckMatch( str, kMenu_FileLoadWord ) )
+		{
+
+			std::cout << "Enter path to the Forth code file [.txt]:\n";
+			if( std::string forth_source; std::cin >> forth_source )
+			{
+				if( std::ifstream fs( forth_source ); fs )
+				{
+#if DEBUG_ON
+					const auto file_index { SourceFileIndex::GetUniqueFileId() };
+					F_compiler.GetSourceFilesMap() [ file_index ] = forth_source;
+					for( TForthReader_4_Debugging fileReader( file_index ); fs; F_compiler( fileReader( fs ) ) ) 
+						;
+#else
+					for( TForthReader fileReader; fs; F_compiler( fileReader( fs ) ) ) 
+						;
+#endif
+
+					F_compiler.GetOutSink().Flush();
+					std::cout << "File processed OK\n" << endl;
+				}
+				else
+				{
+					std::cerr << "\nCannot open the file: " << forth_source << endl;		
+				}
+			}
+			else
+			{
+				std::cerr << "\nWrong file path: " << forth_source << endl;		
+			}
+
+			return true;	// load processed, no matter if the file could be or not properly opened
+		}
+
+		// ---------------------------------------
+		if( CheckMatch( str, kMenu_Help ) )
+		{
+			std::cout << kHelpString << endl;
+			return true;
+		}
+
+	
+		return false;		// no system words, continue with the Forth interpreter
+	}
+
+
+	// ----------------------------
+
+
+}	// The end of the BCForth namespace
+
+
+
@@ -0,0 +1,172 @@
+// ========================================================================
+//
+// The Forth interpreter-compiler by Prof. Boguslaw Cyganek (C) 2021
+//
+// The software is supplied as is and for educational purposes
+// without any guarantees nor responsibility of its use in any application.
+//
+// ========================================================================
+
+
+#pragma once
+
+
+
+#include "Modules.h"
+#include "VectorKernels.h"
+
+
+
+
+namespace BCForth
+{
+
+
+	// --------------------------------------
+	// The packed bit arrays: [#bits][<--- #bits / 64 cells ---->], e.g.
+	//
+	// 1000000 BITS: FLAGS		\ 1M flags in 15.6k cells
+	// 1 FLAGS BITS-FILL		\ all set
+	// 7 FLAGS BIT-CLEAR
+	// 7 FLAGS BIT@ .
+	// FLAGS POPCOUNT .
+	//
+	class BitsModule : public TForthModule
+	{
+
+		using StDatType = TForthCompiler::DataStack::value_type;
+
+		static constexpr StDatType kBitsHeaderCells { 1 };		// #bits
+
+		struct BitArray
+		{
+			StDatType		fNumOfBits {};
+			CellType *		fWords {};
+		};
+
+		static BitArray GetBitArray( StDatType addr )
+		{
+			auto * p { reinterpret_cast< StDatType * >( addr ) };
+			return BitArray { p[ 0 ], p + kBitsHeaderCells };
+		}
+
+		static CellType & WordOf( const BitArray & b, StDatType i )
+		{
+			if( i >= b.fNumOfBits )
+				throw ForthError( "Bit index out of range" );
+			return b.fWords[ i / kBitsPerWord ];
+		}
+
+		static CellType MaskOf( StDatType i ) { return CellType { 1 } << ( i % kBitsPerWord ); }
+
+	public:
+
+		// Call to upload new words to the forth_comp
+		void operator () ( TForthCompiler & forth_comp ) override
+		{
+			BitOperations( forth_comp );
+			BitArrayOperations( forth_comp );
+		}
+
+
+	private:
+
+
+		void BitOperations( TForthCompiler & forth_comp )
+		{
+
+			forth_comp.InsertWord_2_Dict( "BIT@",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[] ( auto & ds )	{	StDatType i, bits;
+										if( ! ( ds.Pop( bits ) && ds.Pop( i ) ) ) return false;
+										return ds.Push( ( WordOf( GetBitArray( bits ), i ) & MaskOf( i ) ) != 0 ? kBoolTrue : kBoolFalse );
+									}	), " i bits -- flag " );
+
+			forth_comp.InsertWord_2_Dict( "BIT!",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[] ( auto & ds )	{	StDatType flag, i, bits;
+										if( ! ( ds.Pop( bits ) && ds.Pop( i ) && ds.Pop( flag ) ) ) return false;
+										auto & w { WordOf( GetBitArray( bits ), i ) };
+										w = flag != 0 ? w | MaskOf( i ) : w & ~ MaskOf( i );
+										return true;
+									}	), " flag i bits -- " );
+
+			forth_comp.InsertWord_2_Dict( "BIT-SET",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[] ( auto & ds )	{	StDatType i, bits;
+										return ds.Pop( bits ) && ds.Pop( i ) ? WordOf( GetBitArray( bits ), i ) |= MaskOf( i ), true : false;
+									}	), " i bits -- " );
+
+			forth_comp.InsertWord_2_Dict( "BIT-CLEAR",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[] ( auto & ds )	{	StDatType i, bits;
+										return ds.Pop( bits ) && ds.Pop( i ) ? WordOf( GetBitArray( bits ), i ) &= ~ MaskOf( i ), true : false;
+									}	), " i bits -- " );
+
+		}
+
+
+
+		void BitArrayOperations( TForthCompiler & forth_comp )
+		{
+
+			forth_comp.InsertWord_2_Dict( "BITS-FILL",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[] ( auto & ds )	{	StDatType flag, bits;
+										if( ! ( ds.Pop( bits ) && ds.Pop( flag ) ) ) return false;
+										const auto b { GetBitArray( bits ) };
+										const auto num_of_words { NumOfBitWords( b.fNumOfBits ) };
+										std::fill_n( b.fWords, num_of_words, flag != 0 ? ~ CellType {} : CellType {} );
+										if( const auto rest { b.fNumOfBits % kBitsPerWord }; flag != 0 && rest != 0 )
+											b.fWords[ num_of_words - 1 ] = ( CellType { 1 } << rest ) - 1;		// the bits past the end stay 0
+										return true;
+									}	), " flag bits -- " );
+
+			// Clears the bits first, first+step, first+2*step, ... e.g. the multiples of a prime in the sieve
+			forth_comp.InsertWord_2_Dict( "BITS-CLEAR-STEP",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[] ( auto & ds )	{	StDatType first, step, bits;
+										if( ! ( ds.Pop( bits ) && ds.Pop( step ) && ds.Pop( first ) ) ) return false;
+										if( step == 0 )
+											throw ForthError( "BITS-CLEAR-STEP - the step cannot be 0" );
+										const auto b { GetBitArray( bits ) };
+										BitClearStep( b.fWords, b.fNumOfBits, first, step );
+										return true;
+									}	), " first step bits -- " );
+
+			forth_comp.InsertWord_2_Dict( "POPCOUNT",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[] ( auto & ds )	{	StDatType bits;
+										if( ! ds.Pop( bits ) ) return false;
+										const auto b { GetBitArray( bits ) };
+										return ds.Push( BitCount( b.fWords, NumOfBitWords( b.fNumOfBits ) ) );
+									}	), " bits -- num_of_set_bits " );
+
+			// The index of the first set bit from i on, or -1 if there is none
+			forth_comp.InsertWord_2_Dict( "FIND-NEXT-SET",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[] ( auto & ds )	{	StDatType i, bits;
+										if( ! ( ds.Pop( bits ) && ds.Pop( i ) ) ) return false;
+										const auto b { GetBitArray( bits ) };
+										const auto j { BitFindNext( b.fWords, b.fNumOfBits, i ) };
+										return ds.Push( j < b.fNumOfBits ? static_cast< StDatType >( j ) : static_cast< StDatType >( -1 ) );
+									}	), " i bits -- j " );
+
+
+
+			DirectTextModule( {
+
+					// e.g.
+					// 1000 BITS: FLAGS
+					// 5 FLAGS BIT-SET
+					// The bits are 0 at the start
+					R"(	: BITS: ( #bits -- | )		CREATE
+									DUP , 63 + 64 / CELLS ALLOT				\\ the number of bits AND the cells for them \n
+								DOES>	( -- bits )		;
+					)"
+
+				} )( forth_comp );
+
+		}
+
+
+
+	};
+
+
+
+}
+
+
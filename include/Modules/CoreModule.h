@@ -1,358 +1,518 @@
-// ========================================================================
-//
-// The Forth interpreter-compiler by Prof. Boguslaw Cyganek (C) 2021
-//
-// The software is supplied as is and for educational purposes
-// without any guarantees nor responsibility of its use in any application. 
-//
-// ========================================================================
-
-
-#pragma once
-
-
-
-
-#include "Modules.h"
-
-#include <ranges>
-
-
-
-namespace BCForth
-{
-
-
-
-	// --------------------------------------
-	// Extra words for the data stack and
-	// for the return stack.
-	class CoreEncodedWords : public TForthModule
-	{
-
-		using DS	= TForth::DataStack;
-		using DS_VT = DS::value_type;
-
-
-	public:
-
-		// Call to upload new words to the forth_comp
-		void operator () ( TForthCompiler & forth_comp ) override
-		{
-
-
-			forth_comp.InsertWord_2_Dict( ".",		std::make_unique< Dot< TForth, SignedIntType > >( forth_comp, forth_comp.GetOutStream() ), " x -- " );
-			forth_comp.InsertWord_2_Dict( ".S",		std::make_unique< Dot_S< TForth, SignedIntType > >( forth_comp, forth_comp.GetOutStream() ), " x -- x " );
-
-
-			forth_comp.InsertWord_2_Dict( ".SD",	std::make_unique< Stack_Dump< TForth, SignedIntType > >( forth_comp, forth_comp.GetOutStream(), Letter_2_Name( kSpace ) ), " x -- x ==> int stack dump " );
-			forth_comp.InsertWord_2_Dict( ".SDU",	std::make_unique< Stack_Dump< TForth, CellType > >( forth_comp, forth_comp.GetOutStream(), Letter_2_Name( kSpace ) ), " x -- x ==> uint stack dump " );
-
-
-
-
-			forth_comp.InsertWord_2_Dict( "DROP",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.Drop();  }	 > >( forth_comp ), " x -- " );
-			forth_comp.InsertWord_2_Dict( "DUP",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.Dup();  }	 > >( forth_comp ), " x -- x x " );
-			forth_comp.InsertWord_2_Dict( "SWAP",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.Swap();  }	 > >( forth_comp ), " x y -- y x " );
-			forth_comp.InsertWord_2_Dict( "OVER",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.Over();  }	 > >( forth_comp ), " x y -- x y x " );
-			forth_comp.InsertWord_2_Dict( "ROT",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.Rot();  }	 > >( forth_comp ), " x y z -- y z x " );
-
-
-			forth_comp.InsertWord_2_Dict( "+",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template Plus< SignedIntType >();  }	 > >( forth_comp ), " x y -- x+y " );
-			forth_comp.InsertWord_2_Dict( "-",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template Minus< SignedIntType >();  }	 > >( forth_comp ), " x y -- x-y " );
-			forth_comp.InsertWord_2_Dict( "*",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template Mult< SignedIntType >();  }	 > >( forth_comp ), " x y -- x*y " );
-			forth_comp.InsertWord_2_Dict( "/",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template Div< SignedIntType >();  }	 > >( forth_comp ), " x y -- x/y " );
-			forth_comp.InsertWord_2_Dict( "MOD",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template Mod< SignedIntType >();  }	 > >( forth_comp ), " x y -- x/y " );
-
-
-
-			using UnarySignOp = StackOp< TForth, SignedIntType, SignedIntType >;
-
-			forth_comp.InsertWord_2_Dict( "NEG",	std::make_unique< UnarySignOp >( forth_comp, [] ( const auto x ) { return -x; } ), " x -- -x " );
-
-
-			forth_comp.InsertWord_2_Dict( "AND",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.And();  }	 > >( forth_comp ), " x y -- x_AND_y " );
-			forth_comp.InsertWord_2_Dict( "OR",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.Or();  }	 > >( forth_comp ), " x y -- x_OR_y " );
-			forth_comp.InsertWord_2_Dict( "XOR",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.Xor();  }	 > >( forth_comp ), " x y -- x_XOR_y " );
-			forth_comp.InsertWord_2_Dict( "~",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.Neg();  }	 > >( forth_comp ), " x -- BIT_INV(x) " );
-
-
-
-			forth_comp.InsertWord_2_Dict( "CR",		std::make_unique< DotQuote< TForth > >( forth_comp, forth_comp.GetOutStream(), Name( kCR ) ) );
-			forth_comp.InsertWord_2_Dict( "TAB",	std::make_unique< DotQuote< TForth > >( forth_comp, forth_comp.GetOutStream(), Letter_2_Name( kTab ) ) );
-			forth_comp.InsertWord_2_Dict( "SPACE",	std::make_unique< DotQuote< TForth > >( forth_comp, forth_comp.GetOutStream(), Letter_2_Name( kSpace ) ) );
-
-
-			forth_comp.InsertWord_2_Dict( "CREATE",	std::make_unique< Create< TForth > >( forth_comp ), " -- " );
-			forth_comp.InsertWord_2_Dict( "ALLOT",	std::make_unique< Allot< TForth > >( forth_comp ), " n_bytes -- " );
-			forth_comp.InsertWord_2_Dict( ",",		std::make_unique< Comma< TForth, CellType > >( forth_comp ), " x -- " );
-			forth_comp.InsertWord_2_Dict( "C,",		std::make_unique< Comma< TForth, RawByte > >( forth_comp ), " c -- " );
-
-			forth_comp.InsertWord_2_Dict( "EXECUTE",std::make_unique< Execute< TForth > >( forth_comp ), " ex_token -- ? " );
-
-			forth_comp.InsertWord_2_Dict( "PAD",	std::make_unique< RawByteArray< TForth > >( forth_comp, k_PAD_Size ), " -- PAD_addr " );
-
-
-
-			// Emit and key
-			forth_comp.InsertWord_2_Dict( "KEY",	std::make_unique< StackOp< TForth, Char > >( forth_comp, [] () { Char c {}; std::cin.get( c ); return c; } ), " -- c " );
-			forth_comp.InsertWord_2_Dict( "EMIT",	std::make_unique< StackOp< TForth, void, Char > >( forth_comp, [ & forth_comp ] ( const auto c ) { forth_comp.GetOutStream() << c; } ), " c -- " );
-			forth_comp.InsertWord_2_Dict( "TYPE",	std::make_unique< StackOp< TForth, void, Char *, CellType > >( forth_comp, [ & forth_comp ] ( const auto addr, const auto len ) { for( auto i{0}; i < len; ++ i ) forth_comp.GetOutStream() << addr[ i ]; } ), " addr len -- " );
-
-
-
-			// Comparisons
-			forth_comp.InsertWord_2_Dict( "=",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template EQ< SignedIntType >();  } > >( forth_comp ), " x y -- x<y " );
-			forth_comp.InsertWord_2_Dict( "<>",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template NE< SignedIntType >();  } > >( forth_comp ), " x y -- x<=y " );
-			forth_comp.InsertWord_2_Dict( "<",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template LT< SignedIntType >();  } > >( forth_comp ), " x y -- x>y " );
-			forth_comp.InsertWord_2_Dict( "<=",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template LE< SignedIntType >();  } > >( forth_comp ), " x y -- x>=y " );
-			forth_comp.InsertWord_2_Dict( ">",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template GT< SignedIntType >();  } > >( forth_comp ), " x y -- x=y " );
-			forth_comp.InsertWord_2_Dict( ">=",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template GE< SignedIntType >();  } > >( forth_comp ), " x y -- x<>y " );
-
-
-
-
-
-			forth_comp.InsertWord_2_Dict( "CELLS",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.Cells();  }						 > >( forth_comp ), " n -- 8*n " );
-			forth_comp.InsertWord_2_Dict( "CELL+",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.CellPlus();  }						 > >( forth_comp ), " addr -- addr+8" );
-			
-			forth_comp.InsertWord_2_Dict( "@",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template ReadAt< CellType >();  }	 > >( forth_comp ), " addr -- [addr] " );
-			forth_comp.InsertWord_2_Dict( "!",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template WriteAt< CellType >();  }	 > >( forth_comp ), " x addr -- " );
-			forth_comp.InsertWord_2_Dict( "+!",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template UpdateAt< CellType >();  }	 > >( forth_comp ), " n addr -- " );
-
-			forth_comp.InsertWord_2_Dict( "C@",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template ReadAt< Char >();  }	 > >( forth_comp ), " c_addr -- [c_addr] " );
-			forth_comp.InsertWord_2_Dict( "C!",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template WriteAt< Char >();  }	 > >( forth_comp ), " c c_addr -- " );
-			forth_comp.InsertWord_2_Dict( "C+!",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template UpdateAt< Char >();  } > >( forth_comp ), " n c_addr -- " );
-
-			forth_comp.InsertWord_2_Dict( "2@",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template DoubleReadAt< CellType >();  }	 > >( forth_comp ), " addr -- [addr] [addr+1] " );
-			forth_comp.InsertWord_2_Dict( "2!",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template DoubleWriteAt< CellType >();  }	 > >( forth_comp ), " x1 x2 addr -- " );
-
-
-			forth_comp.InsertWord_2_Dict( "1+",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template OnePlus< SignedIntType >();  } > >( forth_comp ), " x -- x+1 " );
-			forth_comp.InsertWord_2_Dict( "1-",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template OneMinus< SignedIntType >();  } > >( forth_comp ), " x -- x-1 " );
-			
-			forth_comp.InsertWord_2_Dict( "2+",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template TwoPlus< SignedIntType >();  } > >( forth_comp ), " x -- x+2 " );
-			forth_comp.InsertWord_2_Dict( "2-",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template TwoMinus< SignedIntType >();  } > >( forth_comp ), " x -- x-2 " );
-			forth_comp.InsertWord_2_Dict( "2*",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template TwoTimes< SignedIntType >();  } > >( forth_comp ), " x -- x*2 " );
-			
-			forth_comp.InsertWord_2_Dict( "0=",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template EQ_0< SignedIntType >();  } > >( forth_comp ), " x -- x=0 " );
-			forth_comp.InsertWord_2_Dict( "0<>",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template NE_0< SignedIntType >();  } > >( forth_comp ), " x -- x<>0 " );
-			forth_comp.InsertWord_2_Dict( "0<",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template LT_0< SignedIntType >();  } > >( forth_comp ), " x -- x<0 " );
-			forth_comp.InsertWord_2_Dict( "0<=",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template LE_0< SignedIntType >();  } > >( forth_comp ), " x -- x<=0 " );
-			forth_comp.InsertWord_2_Dict( "0>",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template GT_0< SignedIntType >();  } > >( forth_comp ), " x -- x>0 " );
-			forth_comp.InsertWord_2_Dict( "0>=",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template GE_0< SignedIntType >();  } > >( forth_comp ), " x -- x>=0 " );
-
-
-
-
-
-			// Spec words
-			// List all words already in the dictionary
-			forth_comp.InsertWord_2_Dict( "WORDS",	std::make_unique< StackOp< TForth, void > >( forth_comp, 
-				[ & forth_comp ] () 
-			{ 
-				std::vector< std::tuple< Name, Name, Name > >		name_comm_vec;
-				for( const auto & [ n, w ] : forth_comp.GetWordDict() )
-					name_comm_vec./*push_back*/emplace_back( std::make_tuple( n, w.fWordComment, w.fWordIsImmediate ? " [immediate]" : "" ) );
-				//std::sort( name_comm_vec.begin(), name_comm_vec.end() );
-				std::ranges::sort( name_comm_vec );
-				//std::for_each( name_comm_vec.begin(), name_comm_vec.end(), [ & forth_comp ] ( const auto & t ) { forth_comp.GetOutStream() << std::get<0>( t ) << "\t\t\t" << std::get<1>( t ) << "\t\t\t\t\t" << std::get<2>( t ) << std::endl; } );
-				std::ranges::for_each( name_comm_vec, [ & forth_comp ] ( const auto & t ) { forth_comp.GetOutStream() << std::get<0>( t ) << "\t\t\t" << std::get<1>( t ) << "\t\t\t\t\t" << std::get<2>( t ) << std::endl; } );
-			} ), " -- " );
-
-
-			forth_comp.InsertWord_2_Dict( "ABORT",	std::make_unique< Abort< TForth > >( forth_comp, "ABORT called" ), " -- " );
-
-
-			forth_comp.InsertWord_2_Dict( "LEAVE",	std::make_unique< LEAVE< TForth > >( forth_comp ), " -- " );
-
-		}
-
-	};
-
-
-
-
-	class CoreDefinedWords : public DirectTextModule
-	{
-		  
-		const Name /*&*/ kBL				{ ": BL ( -- space_char ) " + std::to_string( kSpace ) + " ;" };	  
-			  
-		const Name /*&*/ kFALSE_Const	{ std::to_string( kBoolFalse ) + " CONSTANT FALSE" };
-		const Name /*&*/ kTRUE_Const		{ std::to_string( kBoolTrue ) + " CONSTANT TRUE" };
-
-		//const Name			kDebugFileNameWord { ": " + Name( kDebugFileName ) + " S\" BCForthDebugInfoFile.txt\" ;" };
-
-	public:
-
-		CoreDefinedWords( void )
-		{
-		
-			GetWords() =
-			{
-					": 2DUP ( x y -- x y x y ) OVER OVER ;", 
-					": ?DUP ( x -- 0 | x x ) DUP IF DUP THEN ;", 
-					": 2DROP ( x y -- ) DROP DROP ;",
-					": -ROT ( x y z -- z x y ) ROT ROT ;",
-
-
-					": */ ( x y z -- (x*y)/z ) ROT ROT * SWAP / ;",
-
-
-					": ? ( addr -- ) @ . ;",	// a word to query a variable
-
-					": CHARS ( -- ) ;",			// just no-op
-					": CHAR+ ( x -- x+1 ) 1+ ;",
-
-
-					kBL,
-
-
-					": MIN ( n1 n2 -- min{n1,n2} ) 2DUP < IF DROP ELSE SWAP DROP THEN ;",
-					": MAX ( n1 n2 -- max{n1,n2} ) 2DUP > IF DROP ELSE SWAP DROP THEN ;",
-
-
-					R"(: WITHIN ( n1 n2 n3 -- t if n2 <= n1 < n3 )	-ROT					\\ n3 n1 n2				\n
-																	OVER					\\ n3 n1 n2 n1			\n
-																	<=						\\ n3 n1 c1				\n
-																	-ROT					\\ c1 n3 n1				\n
-																	> AND					\\ c1 and c2			\n
-					;)",
-
-
-					": WITHIN? ( n1 n2 n3 -- t if n2 <= n1 <= n3 ) 1+ WITHIN ;",
-
-					// String words
-					": COUNT ( c-addr_1 -- c-addr_2 c-len ) DUP 1+ SWAP C@ ;",
-
-
-
-					// Here go some creational words
-
-
-					// e.g.
-					// 31 CONSTANT DAYS_IN_MAY
-					// DAYS_IN_MAY @ .
-					R"(	: CONSTANT			( n -- | ) 
-									CREATE					\\ at compile time, create new data \n
-										,					\\ write in the value n \n
-									DOES>	( -- n )		\\ what the child does, get data address \n
-									@						\\ get address of data & push its value onto the stack \n
-						; 
-					)",
-
-
-
-
-					// e.g.
-					// 1024 VALUE NUM_BYTES
-					// 2048 TO NUM_BYTES
-					// NUM_BYTES @ .
-					R"(	: VALUE				( n -- | ) 
-									CREATE					\\ at compile time, create new data \n
-										,					\\ write in the value n \n
-									DOES>	( -- n )		\\ what the child does, get data address \n
-									@						\\ get address of data & push its value onto the stack \n
-						; 
-					)",
-
-
-
-					// e.g.
-					// VARIABLE DATA
-					// DATA C@
-					R"(	: VARIABLE			( -- | ) 
-									CREATE 1 CELLS ALLOT	\\ at compile create one cell data	\n
-									DOES>	( -- addr )		\\ at run-time return a variable address \n
-						; 
-					)",
-
-
-
-
-					// e.g.
-					// 100 BUFFER:	DATA	/ create a buffer DATA of 100 bytes
-					// 31 DATA !			/ write 31 to the first cell (8 bytes) of DATA
-					// the same as
-					// CREATE DATA 100 ALLOT
-					R"(	: BUFFER:				( len_bytes -- | )		
-									CREATE ALLOT						\\ at compile create a buffer of len_bytes	\n
-									DOES>		( -- addr )				\\ at run-time return a buffer address	\n
-						; 
-					)",
-
-
-
-					// Use as follows:
-					// 100	ARRAY	VOLT
-					// 230 2 VOLT !			\\ enter 230 to the 3rd cell of the array VOLT
-					// 2 VOLT ?				\\ read and print 3rd cell of VOLT
-					// Here we assume 0-based indexing but the first cell contains the max num of elements
-					R"(	: ARRAY ( n -- | )		CREATE DUP , CELLS ALLOT					\\ allocate the number of cells AND the array buffer \n
-								DOES> ( n -- a ) 
-												SWAP OVER 
-												@ OVER <= ABORT" Index out of range" 						
-
-												1+ CELLS +			;						\\ 1+ to pass the first cell with the number of elements
-					)",
-
-
-
-					// This is a special word to allow CREATE in both, the interpreter
-					// and the compiler modes, e.g. as in the above words ARRAY etc. or
-					// during interpretation
-					// 
-					// CREATE TENS 1 , 10 , 100 , 1000 ,
-					// CREATE TEXT ," The quics brown fox "
-					//
-					// In the above call to CREATE will be interceptedd and redirected
-					// to the [CREATE] instead
-					R"(	: [CREATE]				(  -- )		
-								CREATE								\\ at compile create an (empty yet) buffer	\n
-								DOES>			( -- addr )			\\ at run-time return a buffer address	\n
-					; 
-					)",
-
-
-
-					// These must go AFTER the creational words CONSTANT and VARIABLE
-
-					"VARIABLE BASE",		// define
-
-
-					": HEX 16 BASE ! ;",			
-					": DEC 10 BASE ! ;",		
-
-					"DEC",					// turn decimal on entry
-
-
-
-					//"VARIABLE DEBUGGER",		// define a variable to turn DEBUGGER on and off
-
-					//": DEBUGGER_OFF 0 DEBUGGER ! ;",			
-					//": DEBUGGER_ON  1 DEBUGGER ! ;",		
-
-					//"DEBUGGER_OFF",					// turn DEBUGGER off on entry
-
-					//": DebugFileName S\" BCForthDebugInfoFile.txt\" ;",
-					//kDebugFileNameWord,
-
-					kFALSE_Const,
-					kTRUE_Const,
-
-
-			};		
-		
-		
-		}
-
-
-
-
-	};
-
-
-
-}
-
-
+// ========================================================================
+//
+// The Forth interpreter-compiler by Prof. Boguslaw Cyganek (C) 2021
+//
+// The software is supplied as is and for educational purposes
+// without any guarantees nor responsibility of its use in any application. 
+//
+// ========================================================================
+
+
+#pragma once
+
+
+
+
+#include "Modules.h"
+
+#include <ranges>
+
+
+
+namespace BCForth
+{
+
+
+
+	// --------------------------------------
+	// Extra words for the data stack and
+	// for the return stack.
+	class CoreEncodedWords : public TForthModule
+	{
+
+		using DS	= TForth::DataStack;
+		using DS_VT = DS::value_type;
+
+
+	public:
+
+		// Call to upload new words to the forth_comp
+		void operator () ( TForthCompiler & forth_comp ) override
+		{
+
+
+			forth_comp.InsertWord_2_Dict( ".",		std::make_unique< Dot< TForth, SignedIntType > >( forth_comp, forth_comp.GetOutSink() ), " x -- " );
+			forth_comp.InsertWord_2_Dict( ".S",		std::make_unique< Dot_S< TForth, SignedIntType > >( forth_comp, forth_comp.GetOutSink() ), " x -- x " );
+
+
+			forth_comp.InsertWord_2_Dict( ".SD",	std::make_unique< Stack_Dump< TForth, SignedIntType > >( forth_comp, forth_comp.GetOutSink(), Letter_2_Name( kSpace ) ), " x -- x ==> int stack dump " );
+			forth_comp.InsertWord_2_Dict( ".SDU",	std::make_unique< Stack_Dump< TForth, CellType > >( forth_comp, forth_comp.GetOutSink(), Letter_2_Name( kSpace ) ), " x -- x ==> uint stack dump " );
+
+
+
+
+			forth_comp.InsertWord_2_Dict( "DROP",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.Drop();  }	 > >( forth_comp ), " x -- " );
+			forth_comp.InsertWord_2_Dict( "DUP",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.Dup();  }	 > >( forth_comp ), " x -- x x " );
+			forth_comp.InsertWord_2_Dict( "SWAP",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.Swap();  }	 > >( forth_comp ), " x y -- y x " );
+			forth_comp.InsertWord_2_Dict( "OVER",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.Over();  }	 > >( forth_comp ), " x y -- x y x " );
+			forth_comp.InsertWord_2_Dict( "ROT",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.Rot();  }	 > >( forth_comp ), " x y z -- y z x " );
+
+
+			forth_comp.InsertWord_2_Dict( "+",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template Plus< SignedIntType >();  }	 > >( forth_comp ), " x y -- x+y " );
+			forth_comp.InsertWord_2_Dict( "-",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template Minus< SignedIntType >();  }	 > >( forth_comp ), " x y -- x-y " );
+			forth_comp.InsertWord_2_Dict( "*",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template Mult< SignedIntType >();  }	 > >( forth_comp ), " x y -- x*y " );
+			forth_comp.InsertWord_2_Dict( "/",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template Div< SignedIntType >();  }	 > >( forth_comp ), " x y -- x/y " );
+			forth_comp.InsertWord_2_Dict( "MOD",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template Mod< SignedIntType >();  }	 > >( forth_comp ), " x y -- x/y " );
+
+
+			// Double-cell numbers ( lo hi ), the high cell on top
+			forth_comp.InsertWord_2_Dict( "D+",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.DPlus();  }	 > >( forth_comp ), " d1 d2 -- d1+d2 " );
+			forth_comp.InsertWord_2_Dict( "D-",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.DMinus();  }	 > >( forth_comp ), " d1 d2 -- d1-d2 " );
+			forth_comp.InsertWord_2_Dict( "DNEGATE",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.DNegate();  }	 > >( forth_comp ), " d -- -d " );
+			forth_comp.InsertWord_2_Dict( "S>D",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.SToD();  }	 > >( forth_comp ), " n -- d " );
+			forth_comp.InsertWord_2_Dict( "UM*",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.UMStar();  }	 > >( forth_comp ), " u1 u2 -- ud " );
+			forth_comp.InsertWord_2_Dict( "M*",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.MStar();  }	 > >( forth_comp ), " n1 n2 -- d " );
+			forth_comp.InsertWord_2_Dict( "UM/MOD",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.UMSlashMod();  }	 > >( forth_comp ), " ud u -- u_rem u_quot " );
+			forth_comp.InsertWord_2_Dict( "SM/REM",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.SMSlashRem();  }	 > >( forth_comp ), " d n -- n_rem n_quot " );
+			forth_comp.InsertWord_2_Dict( "*/MOD",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template StarSlashMod< true >();  }	 > >( forth_comp ), " n1 n2 n3 -- n_rem n1*n2/n3 " );
+			forth_comp.InsertWord_2_Dict( "*/",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template StarSlashMod< false >();  }	 > >( forth_comp ), " n1 n2 n3 -- n1*n2/n3 " );
+
+
+
+			using UnarySignOp = StackOp< TForth, SignedIntType, SignedIntType >;
+
+			forth_comp.InsertWord_2_Dict( "NEG",	std::make_unique< UnarySignOp >( forth_comp, [] ( const auto x ) { return -x; } ), " x -- -x " );
+
+
+			forth_comp.InsertWord_2_Dict( "AND",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.And();  }	 > >( forth_comp ), " x y -- x_AND_y " );
+			forth_comp.InsertWord_2_Dict( "OR",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.Or();  }	 > >( forth_comp ), " x y -- x_OR_y " );
+			forth_comp.InsertWord_2_Dict( "XOR",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.Xor();  }	 > >( forth_comp ), " x y -- x_XOR_y " );
+			forth_comp.InsertWord_2_Dict( "~",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.Neg();  }	 > >( forth_comp ), " x -- BIT_INV(x) " );
+
+
+
+			forth_comp.InsertWord_2_Dict( "CR",		std::make_unique< DotQuote< TForth > >( forth_comp, forth_comp.GetOutSink(), Name( kCR ) ) );
+			forth_comp.InsertWord_2_Dict( "TAB",	std::make_unique< DotQuote< TForth > >( forth_comp, forth_comp.GetOutSink(), Letter_2_Name( kTab ) ) );
+			forth_comp.InsertWord_2_Dict( "SPACE",	std::make_unique< DotQuote< TForth > >( forth_comp, forth_comp.GetOutSink(), Letter_2_Name( kSpace ) ) );
+
+
+			forth_comp.InsertWord_2_Dict( "CREATE",	std::make_unique< Create< TForth > >( forth_comp ), " -- " );
+			forth_comp.InsertWord_2_Dict( ">BODY",	std::make_unique< StackOp< TForth, CellType, CellType > >( forth_comp, [] ( const auto xt ) 
+				{ 
+					// The data field of a CREATEd word (also with DOES>), e.g. ' DATA >BODY
+					if( auto * cw = dynamic_cast< CompoWord< TForth > * >( reinterpret_cast< TWord< TForth > * >( xt ) ); cw && cw->GetWordsVec().size() > 0 )
+						if( auto * data_field = dynamic_cast< DataField< TForth > * >( cw->GetWordsVec()[ 0 ] ) )
+							return reinterpret_cast< CellType >( data_field->GetBody() );
+					throw ForthError( ">BODY - not a CREATEd word" );
+				} ), " xt -- addr " );
+			forth_comp.InsertWord_2_Dict( "ALLOT",	std::make_unique< Allot< TForth > >( forth_comp ), " n_bytes -- " );
+			forth_comp.InsertWord_2_Dict( ",",		std::make_unique< Comma< TForth, CellType > >( forth_comp ), " x -- " );
+			forth_comp.InsertWord_2_Dict( "C,",		std::make_unique< Comma< TForth, RawByte > >( forth_comp ), " c -- " );
+
+			// The data space - CREATE, ALLOT and , (comma) go to HERE
+			forth_comp.InsertWord_2_Dict( "HERE",		std::make_unique< StackOp< TForth, RawByte * > >( forth_comp, [ & forth_comp ] () { return forth_comp.GetDataSpace().Here(); } ), " -- addr " );
+			forth_comp.InsertWord_2_Dict( "ALIGN",		std::make_unique< StackOp< TForth, void > >( forth_comp, [ & forth_comp ] () { forth_comp.GetDataSpace().Align(); } ), " -- " );
+			forth_comp.InsertWord_2_Dict( "ALIGN-TO",	std::make_unique< StackOp< TForth, void, CellType > >( forth_comp, [ & forth_comp ] ( const auto n ) { forth_comp.GetDataSpace().Align( n ); } ), " n -- " );
+			forth_comp.InsertWord_2_Dict( "ALIGNED",	std::make_unique< StackOp< TForth, CellType, CellType > >( forth_comp, [] ( const auto addr ) { return TDataSpace::Aligned( addr ); } ), " addr -- a_addr " );
+			forth_comp.InsertWord_2_Dict( "UNUSED",		std::make_unique< StackOp< TForth, CellType > >( forth_comp, [ & forth_comp ] () { return forth_comp.GetDataSpace().Unused(); } ), " -- u " );
+
+			forth_comp.InsertWord_2_Dict( "EXECUTE",std::make_unique< Execute< TForth > >( forth_comp ), " ex_token -- ? " );
+
+			// Interprets the text as if it was a line (or lines) of the input. The transient data made by the text
+			// (e.g. the strings of S") belongs to the calling line, so it can be left on the stack - it is freed with that line.
+			forth_comp.InsertWord_2_Dict( "EVALUATE",	std::make_unique< StackOp< TForth, void, Char *, CellType > >( forth_comp, [ & forth_comp ] ( const auto addr, const auto len ) 
+				{ 
+					std::istringstream ss( std::string( addr, len ) );
+					for( TForthReader reader; ss; forth_comp( reader( ss ) ) )
+						;
+				} ), " addr len -- ? " );
+
+			forth_comp.InsertWord_2_Dict( "PAD",	std::make_unique< RawByteArray< TForth > >( forth_comp, k_PAD_Size ), " -- PAD_addr " );
+
+			// The next of the scratch buffers in a ring (1 kB each, 256 bytes on the ESP32) - it stays untouched for the next 3 SCRATCH calls
+			forth_comp.InsertWord_2_Dict( "SCRATCH",	std::make_unique< StackOp< TForth, RawByte * > >( forth_comp, [ & forth_comp ] () { return forth_comp.GetScratchRing().Next(); } ), " -- addr " );
+
+
+
+			// Emit and key
+			forth_comp.InsertWord_2_Dict( "KEY",	std::make_unique< StackOp< TForth, Char > >( forth_comp, [ & forth_comp ] () { forth_comp.GetOutSink().Flush(); Char c {}; std::cin.get( c ); return c; } ), " -- c " );
+			forth_comp.InsertWord_2_Dict( "EMIT",	std::make_unique< StackOp< TForth, void, Char > >( forth_comp, [ & forth_comp ] ( const auto c ) { forth_comp.GetOutSink().Put( c ); } ), " c -- " );
+			forth_comp.InsertWord_2_Dict( "TYPE",	std::make_unique< StackOp< TForth, void, Char *, CellType > >( forth_comp, [ & forth_comp ] ( const auto addr, const auto len ) { forth_comp.GetOutSink().Write( std::string_view( addr, len ) ); } ), " addr len -- " );
+
+
+
+			// Comparisons
+			forth_comp.InsertWord_2_Dict( "=",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template EQ< SignedIntType >();  } > >( forth_comp ), " x y -- x<y " );
+			forth_comp.InsertWord_2_Dict( "<>",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template NE< SignedIntType >();  } > >( forth_comp ), " x y -- x<=y " );
+			forth_comp.InsertWord_2_Dict( "<",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template LT< SignedIntType >();  } > >( forth_comp ), " x y -- x>y " );
+			forth_comp.InsertWord_2_Dict( "<=",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template LE< SignedIntType >();  } > >( forth_comp ), " x y -- x>=y " );
+			forth_comp.InsertWord_2_Dict( ">",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template GT< SignedIntType >();  } > >( forth_comp ), " x y -- x=y " );
+			forth_comp.InsertWord_2_Dict( ">=",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template GE< SignedIntType >();  } > >( forth_comp ), " x y -- x<>y " );
+
+
+
+
+
+			forth_comp.InsertWord_2_Dict( "CELLS",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.Cells();  }						 > >( forth_comp ), " n -- 8*n " );
+			forth_comp.InsertWord_2_Dict( "CELL+",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.CellPlus();  }						 > >( forth_comp ), " addr -- addr+8" );
+			
+			forth_comp.InsertWord_2_Dict( "@",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template ReadAt< CellType >();  }	 > >( forth_comp ), " addr -- [addr] " );
+			forth_comp.InsertWord_2_Dict( "!",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template WriteAt< CellType >();  }	 > >( forth_comp ), " x addr -- " );
+			forth_comp.InsertWord_2_Dict( "+!",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template UpdateAt< CellType >();  }	 > >( forth_comp ), " n addr -- " );
+
+			forth_comp.InsertWord_2_Dict( "C@",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template ReadAt< Char >();  }	 > >( forth_comp ), " c_addr -- [c_addr] " );
+			forth_comp.InsertWord_2_Dict( "C!",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template WriteAt< Char >();  }	 > >( forth_comp ), " c c_addr -- " );
+			forth_comp.InsertWord_2_Dict( "C+!",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template UpdateAt< Char >();  } > >( forth_comp ), " n c_addr -- " );
+
+			forth_comp.InsertWord_2_Dict( "2@",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template DoubleReadAt< CellType >();  }	 > >( forth_comp ), " addr -- [addr] [addr+1] " );
+			forth_comp.InsertWord_2_Dict( "2!",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template DoubleWriteAt< CellType >();  }	 > >( forth_comp ), " x1 x2 addr -- " );
+
+
+			forth_comp.InsertWord_2_Dict( "1+",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template OnePlus< SignedIntType >();  } > >( forth_comp ), " x -- x+1 " );
+			forth_comp.InsertWord_2_Dict( "1-",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template OneMinus< SignedIntType >();  } > >( forth_comp ), " x -- x-1 " );
+			
+			forth_comp.InsertWord_2_Dict( "2+",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template TwoPlus< SignedIntType >();  } > >( forth_comp ), " x -- x+2 " );
+			forth_comp.InsertWord_2_Dict( "2-",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template TwoMinus< SignedIntType >();  } > >( forth_comp ), " x -- x-2 " );
+			forth_comp.InsertWord_2_Dict( "2*",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template TwoTimes< SignedIntType >();  } > >( forth_comp ), " x -- x*2 " );
+			
+			forth_comp.InsertWord_2_Dict( "0=",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template EQ_0< SignedIntType >();  } > >( forth_comp ), " x -- x=0 " );
+			forth_comp.InsertWord_2_Dict( "0<>",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template NE_0< SignedIntType >();  } > >( forth_comp ), " x -- x<>0 " );
+			forth_comp.InsertWord_2_Dict( "0<",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template LT_0< SignedIntType >();  } > >( forth_comp ), " x -- x<0 " );
+			forth_comp.InsertWord_2_Dict( "0<=",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template LE_0< SignedIntType >();  } > >( forth_comp ), " x -- x<=0 " );
+			forth_comp.InsertWord_2_Dict( "0>",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template GT_0< SignedIntType >();  } > >( forth_comp ), " x -- x>0 " );
+			forth_comp.InsertWord_2_Dict( "0>=",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template GE_0< SignedIntType >();  } > >( forth_comp ), " x -- x>=0 " );
+
+
+
+
+
+			// Spec words
+			// List all words in the first word list of the search order
+			forth_comp.InsertWord_2_Dict( "WORDS",	std::make_unique< StackOp< TForth, void > >( forth_comp, 
+				[ & forth_comp ] () 
+			{ 
+				std::vector< std::tuple< Name, Name, Name > >		name_comm_vec;
+				for( const auto & [ n, w ] : forth_comp.GetWordList( forth_comp.GetSearchOrder().size() > 0 ? forth_comp.GetSearchOrder()[ 0 ] : forth_comp.GetCurrent() ) )
+					name_comm_vec./*push_back*/emplace_back( std::make_tuple( n, Name( forth_comp.GetWordComment( w.fWordUP.get() ) ), w.fWordIsImmediate ? " [immediate]" : "" ) );
+				//std::sort( name_comm_vec.begin(), name_comm_vec.end() );
+				std::ranges::sort( name_comm_vec );
+				//std::for_each( name_comm_vec.begin(), name_comm_vec.end(), [ & forth_comp ] ( const auto & t ) { forth_comp.GetOutStream() << std::get<0>( t ) << "\t\t\t" << std::get<1>( t ) << "\t\t\t\t\t" << std::get<2>( t ) << std::endl; } );
+				std::ranges::for_each( name_comm_vec, [ & forth_comp ] ( const auto & t ) { forth_comp.GetOutStream() << std::get<0>( t ) << "\t\t\t" << std::get<1>( t ) << "\t\t\t\t\t" << std::get<2>( t ) << std::endl; } );
+			} ), " -- " );
+
+
+			// After the start-up, the word lists can be turned into the perfect hash tables for a faster lookup
+			forth_comp.InsertWord_2_Dict( "FREEZE-DICTIONARY",	std::make_unique< StackOp< TForth, void > >( forth_comp, [ & forth_comp ] () { forth_comp.FreezeDictionary(); } ), " -- " );
+
+
+			// The memory taken by the words and their compiled-in nodes
+			forth_comp.InsertWord_2_Dict( ".MEMORY",	std::make_unique< StackOp< TForth, void > >( forth_comp, 
+				[ & forth_comp ] () 
+			{ 
+				size_type num_of_words {}, body_bytes {};
+				for( TForth::WordListId wid {}; wid < forth_comp.GetNumOfWordLists(); ++ wid )
+					for( const auto & [ n, w ] : forth_comp.GetWordList( wid ) )
+						++ num_of_words, body_bytes += w.fWordUP->GetHeapBytes();
+
+				const auto & node_repo { forth_comp.GetNodeRepo() };
+				for( const auto & node : node_repo )
+					body_bytes += node->GetHeapBytes();
+
+				const auto & arena { GetNodeArena() };
+				auto & os { forth_comp.GetOutSink() };
+				os.Write( "node arena:       " ), os.PutInt( arena.GetBytesInUse() ), os.Write( " of " ), os.PutInt( arena.GetBytesReserved() ), os.Write( " bytes in use" ), os.Write( kCR );
+				os.Write( "words:            " ), os.PutInt( num_of_words ), os.Write( kCR );
+				os.Write( "compiled nodes:   " ), os.PutInt( node_repo.size() ), os.Write( kCR );
+				os.Write( "transient arena:  " ), os.PutInt( forth_comp.GetTransientArena().GetBytesReserved() ), os.Write( " bytes reserved" ), os.Write( kCR );
+				os.Write( "data space:       " ), os.PutInt( forth_comp.GetDataSpace().GetHereOffset() ), os.Write( " of " ), os.PutInt( forth_comp.GetDataSpace().GetSize() ), os.Write( " bytes in use" ), os.Write( kCR );
+				os.Write( "body heap bytes:  " ), os.PutInt( body_bytes ), os.Write( kCR );
+				os.Write( "sizeof IF node:   " ), os.PutInt( sizeof( IF< TForth > ) ), os.Write( kCR );
+			} ), " -- " );
+
+
+			// The search-order words
+			// The word list ids are pushed in the Forth's order, i.e. the first to search is on top
+			forth_comp.InsertWord_2_Dict( "FORTH-WORDLIST",	std::make_unique< StackOp< TForth, CellType > >( forth_comp, [] () { return TForth::kForthWordList; } ), " -- wid " );
+			forth_comp.InsertWord_2_Dict( "WORDLIST",		std::make_unique< StackOp< TForth, CellType > >( forth_comp, [ & forth_comp ] () { return forth_comp.CreateWordList(); } ), " -- wid " );
+			forth_comp.InsertWord_2_Dict( "GET-CURRENT",	std::make_unique< StackOp< TForth, CellType > >( forth_comp, [ & forth_comp ] () { return forth_comp.GetCurrent(); } ), " -- wid " );
+			forth_comp.InsertWord_2_Dict( "SET-CURRENT",	std::make_unique< StackOp< TForth, void, CellType > >( forth_comp, [ & forth_comp ] ( const auto wid ) { forth_comp.SetCurrent( wid ); } ), " wid -- " );
+
+			forth_comp.InsertWord_2_Dict( "GET-ORDER",	std::make_unique< StackOp< TForth, void > >( forth_comp, 
+				[ & forth_comp ] () 
+			{ 
+				auto & ds { forth_comp.GetDataStack() };
+				const auto & so { forth_comp.GetSearchOrder() };
+				for( auto it = so.rbegin(); it != so.rend(); ++ it )
+					if( ds.Push( * it ) == false )
+						throw ForthError( "stack overflow" );
+				if( ds.Push( so.size() ) == false )
+					throw ForthError( "stack overflow" );
+			} ), " -- widn ... wid1 n " );
+
+			forth_comp.InsertWord_2_Dict( "SET-ORDER",	std::make_unique< StackOp< TForth, void, SignedIntType > >( forth_comp, 
+				[ & forth_comp ] ( const SignedIntType n ) 
+			{ 
+				if( n == -1 )
+				{
+					forth_comp.SetSearchOrder( { TForth::kForthWordList } );		// the minimum search order
+					return;
+				}
+
+				auto & ds { forth_comp.GetDataStack() };
+				if( n < 0 || static_cast< size_type >( n ) > ds.size() )
+					throw ForthError( "SET-ORDER - wrong number of word lists" );
+
+				std::vector< TForth::WordListId > so( n );
+				for( auto & wid : so )
+					ds.Pop( wid );			// wid1 is on top
+				forth_comp.SetSearchOrder( std::move( so ) );
+			} ), " widn ... wid1 n -- " );
+
+			forth_comp.InsertWord_2_Dict( "ONLY",		std::make_unique< StackOp< TForth, void > >( forth_comp, [ & forth_comp ] () { forth_comp.SetSearchOrder( { TForth::kForthWordList } ); } ), " -- " );
+			forth_comp.InsertWord_2_Dict( "ALSO",		std::make_unique< StackOp< TForth, void > >( forth_comp, 
+				[ & forth_comp ] () 
+			{ 
+				auto so { forth_comp.GetSearchOrder() };
+				so.insert( so.begin(), so.size() > 0 ? so[ 0 ] : TForth::kForthWordList );
+				forth_comp.SetSearchOrder( std::move( so ) );
+			} ), " -- " );
+			forth_comp.InsertWord_2_Dict( "PREVIOUS",	std::make_unique< StackOp< TForth, void > >( forth_comp, 
+				[ & forth_comp ] () 
+			{ 
+				auto so { forth_comp.GetSearchOrder() };
+				if( so.size() == 0 )
+					throw ForthError( "search-order underflow" );
+				so.erase( so.begin() );
+				forth_comp.SetSearchOrder( std::move( so ) );
+			} ), " -- " );
+			forth_comp.InsertWord_2_Dict( "FORTH",		std::make_unique< StackOp< TForth, void > >( forth_comp, 
+				[ & forth_comp ] () 
+			{ 
+				auto so { forth_comp.GetSearchOrder() };
+				if( so.size() == 0 )
+					so.push_back( TForth::kForthWordList );
+				else
+					so[ 0 ] = TForth::kForthWordList;
+				forth_comp.SetSearchOrder( std::move( so ) );
+			} ), " -- " );
+			forth_comp.InsertWord_2_Dict( "DEFINITIONS",	std::make_unique< StackOp< TForth, void > >( forth_comp, 
+				[ & forth_comp ] () 
+			{ 
+				if( const auto & so { forth_comp.GetSearchOrder() }; so.size() > 0 )
+					forth_comp.SetCurrent( so[ 0 ] );
+			} ), " -- " );
+			forth_comp.InsertWord_2_Dict( "ORDER",		std::make_unique< StackOp< TForth, void > >( forth_comp, 
+				[ & forth_comp ] () 
+			{ 
+				auto & os { forth_comp.GetOutSink() };
+				std::ranges::for_each( forth_comp.GetSearchOrder(), [ & os ] ( const auto wid ) { os.PutInt( wid ); os.Put( kSpace ); } );
+				os.Write( " current: " );
+				os.PutInt( forth_comp.GetCurrent() );
+				os.Write( kCR );
+			} ), " -- " );
+
+
+			forth_comp.InsertWord_2_Dict( "ABORT",	std::make_unique< Abort< TForth > >( forth_comp, "ABORT called" ), " -- " );
+
+
+			forth_comp.InsertWord_2_Dict( "LEAVE",	std::make_unique< LEAVE< TForth > >( forth_comp ), " -- " );
+
+		}
+
+	};
+
+
+
+
+	class CoreDefinedWords : public DirectTextModule
+	{
+		  
+		const Name /*&*/ kBL				{ ": BL ( -- space_char ) " + std::to_string( kSpace ) + " ;" };	  
+			  
+		const Name /*&*/ kFALSE_Const	{ std::to_string( kBoolFalse ) + " CONSTANT FALSE" };
+		const Name /*&*/ kTRUE_Const		{ std::to_string( kBoolTrue ) + " CONSTANT TRUE" };
+
+		//const Name			kDebugFileNameWord { ": " + Name( kDebugFileName ) + " S\" BCForthDebugInfoFile.txt\" ;" };
+
+	public:
+
+		CoreDefinedWords( void )
+		{
+		
+			GetWords() =
+			{
+					": 2DUP ( x y -- x y x y ) OVER OVER ;", 
+					": ?DUP ( x -- 0 | x x ) DUP IF DUP THEN ;", 
+					": 2DROP ( x y -- ) DROP DROP ;",
+					": -ROT ( x y z -- z x y ) ROT ROT ;",
+
+
+					": ? ( addr -- ) @ . ;",	// a word to query a variable
+
+					": CHARS ( -- ) ;",			// just no-op
+					": CHAR+ ( x -- x+1 ) 1+ ;",
+
+
+					kBL,
+
+
+					": MIN ( n1 n2 -- min{n1,n2} ) 2DUP < IF DROP ELSE SWAP DROP THEN ;",
+					": MAX ( n1 n2 -- max{n1,n2} ) 2DUP > IF DROP ELSE SWAP DROP THEN ;",
+
+
+					R"(: WITHIN ( n1 n2 n3 -- t if n2 <= n1 < n3 )	-ROT					\\ n3 n1 n2				\n
+																	OVER					\\ n3 n1 n2 n1			\n
+																	<=						\\ n3 n1 c1				\n
+																	-ROT					\\ c1 n3 n1				\n
+																	> AND					\\ c1 and c2			\n
+					;)",
+
+
+					": WITHIN? ( n1 n2 n3 -- t if n2 <= n1 <= n3 ) 1+ WITHIN ;",
+
+					// String words
+					": COUNT ( c-addr_1 -- c-addr_2 c-len ) DUP 1+ SWAP C@ ;",
+
+
+
+					// Here go some creational words
+
+
+					// e.g.
+					// 31 CONSTANT DAYS_IN_MAY
+					// DAYS_IN_MAY @ .
+					R"(	: CONSTANT			( n -- | ) 
+									CREATE					\\ at compile time, create new data \n
+										,					\\ write in the value n \n
+									DOES>	( -- n )		\\ what the child does, get data address \n
+									@						\\ get address of data & push its value onto the stack \n
+						; 
+					)",
+
+
+
+
+					// e.g.
+					// 1024 VALUE NUM_BYTES
+					// 2048 TO NUM_BYTES
+					// NUM_BYTES @ .
+					R"(	: VALUE				( n -- | ) 
+									CREATE					\\ at compile time, create new data \n
+										,					\\ write in the value n \n
+									DOES>	( -- n )		\\ what the child does, get data address \n
+									@						\\ get address of data & push its value onto the stack \n
+						; 
+					)",
+
+
+
+					// e.g.
+					// VARIABLE DATA
+					// DATA C@
+					R"(	: VARIABLE			( -- | ) 
+									CREATE 1 CELLS ALLOT	\\ at compile create one cell data	\n
+									DOES>	( -- addr )		\\ at run-time return a variable address \n
+						; 
+					)",
+
+
+
+
+					// e.g.
+					// 100 BUFFER:	DATA	/ create a buffer DATA of 100 bytes
+					// 31 DATA !			/ write 31 to the first cell (8 bytes) of DATA
+					// the same as
+					// CREATE DATA 100 ALLOT
+					R"(	: BUFFER:				( len_bytes -- | )		
+									CREATE ALLOT						\\ at compile create a buffer of len_bytes	\n
+									DOES>		( -- addr )				\\ at run-time return a buffer address	\n
+						; 
+					)",
+
+
+
+					// e.g.
+					// 1024 64 ALIGNED-BUFFER: SAMPLES	/ a buffer of 1024 bytes on a cache line boundary
+					// The alignment is a power of 2, e.g. 16 or 32 for the SIMD loads, 64 for a cache line
+					R"(	: ALIGNED-BUFFER:		( len_bytes alignment -- | )		
+									ALIGN-TO							\\ HERE goes to the boundary, so does the data of CREATE	\n
+									CREATE ALLOT						\\ at compile create a buffer of len_bytes	\n
+									DOES>		( -- addr )				\\ at run-time return a buffer address	\n
+						; 
+					)",
+
+
+
+					// Use as follows:
+					// 100	ARRAY	VOLT
+					// 230 2 VOLT !			\\ enter 230 to the 3rd cell of the array VOLT
+					// 2 VOLT ?				\\ read and print 3rd cell of VOLT
+					// Here we assume 0-based indexing but the first cell contains the max num of elements
+					R"(	: ARRAY ( n -- | )		CREATE DUP , CELLS ALLOT					\\ allocate the number of cells AND the array buffer \n
+								DOES> ( n -- a ) 
+												SWAP OVER 
+												@ OVER <= ABORT" Index out of range" 						
+
+												1+ CELLS +			;						\\ 1+ to pass the first cell with the number of elements
+					)",
+
+
+
+					// This is a special word to allow CREATE in both, the interpreter
+					// and the compiler modes, e.g. as in the above words ARRAY etc. or
+					// during interpretation
+					// 
+					// CREATE TENS 1 , 10 , 100 , 1000 ,
+					// CREATE TEXT ," The quics brown fox "
+					//
+					// In the above call to CREATE will be interceptedd and redirected
+					// to the [CREATE] instead
+					R"(	: [CREATE]				(  -- )		
+								CREATE								\\ at compile create an (empty yet) buffer	\n
+								DOES>			( -- addr )			\\ at run-time return a buffer address	\n
+					; 
+					)",
+
+
+
+					// These must go AFTER the creational words CONSTANT and VARIABLE
+
+					"VARIABLE BASE",		// define
+
+
+					": HEX 16 BASE ! ;",			
+					": DEC 10 BASE ! ;",		
+
+					"DEC",					// turn decimal on entry
+
+
+
+					//"VARIABLE DEBUGGER",		// define a variable to turn DEBUGGER on and off
+
+					//": DEBUGGER_OFF 0 DEBUGGER ! ;",			
+					//": DEBUGGER_ON  1 DEBUGGER ! ;",		
+
+					//"DEBUGGER_OFF",					// turn DEBUGGER off on entry
+
+					//": DebugFileName S\" BCForthDebugInfoFile.txt\" ;",
+					//kDebugFileNameWord,
+
+					kFALSE_Const,
+					kTRUE_Const,
+
+
+			};		
+		
+		
+		}
+
+
+
+
+	};
+
+
+
+}
+
+
@@ -1,87 +1,118 @@
-// ========================================================================
-//
-// The Forth interpreter-compiler by Prof. Boguslaw Cyganek (C) 2021
-//
-// The software is supplied as is and for educational purposes
-// without any guarantees nor responsibility of its use in any application. 
-//
-// ========================================================================
-
-
-#pragma once
-
-
-
-#include "Words.h"
-#include "ForthCompiler.h"
-#include <cmath>
-#include <random>
-
-
-
-namespace BCForth
-{
-
-
-	class FP_Module : public TForthModule
-	{
-
-
-
-	public:
-
-		// Call to upload new words to the forth_comp
-		void operator () ( TForthCompiler & forth_comp ) override
-		{
-
-
-			forth_comp.InsertWord_2_Dict( ".F",		std::make_unique< Dot< TForth, FloatType > >( forth_comp, forth_comp.GetOutStream() ), " xf -- " );
-			forth_comp.InsertWord_2_Dict( ".FS",	std::make_unique< Dot_S< TForth, FloatType > >( forth_comp, forth_comp.GetOutStream() ), " xf -- xf " );
-			forth_comp.InsertWord_2_Dict( ".SDF",	std::make_unique< Stack_Dump< TForth, FloatType > >( forth_comp, forth_comp.GetOutStream(), Letter_2_Name( kSpace ) ), " x -- x ==> float stack dump " );
-
-
-			forth_comp.InsertWord_2_Dict( "F+",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template Plus< FloatType >(); }	> >( forth_comp ), " xf yf -- xf+yf " );
-			forth_comp.InsertWord_2_Dict( "F-",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template Minus< FloatType >(); }	> >( forth_comp ), " xf yf -- xf-yf " );
-			forth_comp.InsertWord_2_Dict( "F*",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template Mult< FloatType >(); }	> >( forth_comp ), " xf yf -- xf*yf " );
-			forth_comp.InsertWord_2_Dict( "F/",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template Div< FloatType >(); }		> >( forth_comp ), " xf yf -- xf/yf " );
-
-
-			forth_comp.InsertWord_2_Dict( "F=",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template EQ< FloatType >();  } > >( forth_comp ), " xf yf -- xf<yf " );
-			forth_comp.InsertWord_2_Dict( "F<>",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template NE< FloatType >();  } > >( forth_comp ), " xf yf -- xf<=yf " );
-			forth_comp.InsertWord_2_Dict( "F<",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template LT< FloatType >();  } > >( forth_comp ), " xf yf -- xf>yf " );
-			forth_comp.InsertWord_2_Dict( "F<=",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template LE< FloatType >();  } > >( forth_comp ), " xf yf -- xf>=yf " );
-			forth_comp.InsertWord_2_Dict( "F>",		std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template GT< FloatType >();  } > >( forth_comp ), " xf yf -- xf=yf " );
-			forth_comp.InsertWord_2_Dict( "F>=",	std::make_unique< ExGenericStackOp< TForth, [] ( auto & ds ) { return ds.template GE< FloatType >();  } > >( forth_comp ), " xf yf -- xf<>yf " );
-
-
-			using UnaryFloatOp = StackOp< TForth, FloatType, FloatType >;
-			using BinFloatOp = StackOp< TForth, FloatType, FloatType, FloatType >;
-
-			forth_comp.InsertWord_2_Dict( "FNEG",	std::make_unique< UnaryFloatOp >( forth_comp, [] ( const auto x ) { return -x; } ), " x -- -x " );
-
-
-			forth_comp.InsertWord_2_Dict( "SQRT",	std::make_unique< UnaryFloatOp >( forth_comp, [] ( const auto x ) { return std::sqrt( x ); } ), " xf -- sqrt(xf) " );
-			forth_comp.InsertWord_2_Dict( "POW",	std::make_unique< BinFloatOp >( forth_comp, [] ( const auto x, const auto y ) { return std::pow( x, y ); } ), " xf yf -- pow(xf,yf) " );
-
-
-			forth_comp.InsertWord_2_Dict( "SIN",	std::make_unique< UnaryFloatOp >( forth_comp, [] ( const auto x ) { return std::sin( x ); } ), " xf -- sin(xf) " );
-			forth_comp.InsertWord_2_Dict( "COS",	std::make_unique< UnaryFloatOp >( forth_comp, [] ( const auto x ) { return std::cos( x ); } ), " xf -- cos(xf) " );
-			forth_comp.InsertWord_2_Dict( "TAN",	std::make_unique< UnaryFloatOp >( forth_comp, [] ( const auto x ) { return std::tan( x ); } ), " xf -- tan(xf) " );
-			forth_comp.InsertWord_2_Dict( "ATAN",	std::make_unique< UnaryFloatOp >( forth_comp, [] ( const auto x ) { return std::tan( x ); } ), " xf -- atan(xf) " );
-			forth_comp.InsertWord_2_Dict( "ATAN2",	std::make_unique< BinFloatOp >( forth_comp, [] ( const auto x, const auto y ) { return std::atan2( x, y ); } ), " xf yf -- atan2(xf,yf) " );
-
-
-			// Convert the top data int->float, float->int
-			forth_comp.InsertWord_2_Dict( "2INT",	std::make_unique< StackOp< TForth, SignedIntType, FloatType > >( forth_comp, [] ( const auto x ) { return static_cast< SignedIntType >( x ); } ), " f -- i " );
-			forth_comp.InsertWord_2_Dict( "2FP",	std::make_unique< StackOp< TForth, FloatType, SignedIntType > >( forth_comp, [] ( const auto x ) { return static_cast< FloatType >( x ); } ), " i -- f " );
-
-		}
-
-	};
-
-
-
-}
-
-
-
+// ========================================================================
+//
+// The Forth interpreter-compiler by Prof. Boguslaw Cyganek (C) 2021
+//
+// The software is supplied as is and for educational purposes
+// without any guarantees nor responsibility of its use in any application. 
+//
+// ========================================================================
+
+
+#pragma once
+
+
+
+#include "Words.h"
+#include "ForthCompiler.h"
+#include "Modules.h"
+#include <cmath>
+#include <random>
+
+
+
+namespace BCForth
+{
+
+
+	class FP_Module : public TForthModule
+	{
+
+
+
+	public:
+
+		// Call to upload new words to the forth_comp
+		void operator () ( TForthCompiler & forth_comp ) override
+		{
+
+
+			forth_comp.InsertWord_2_Dict( ".F",		std::make_unique< Dot< TForth, FloatType > >( forth_comp, forth_comp.GetOutSink() ), " xf -- " );
+			forth_comp.InsertWord_2_Dict( ".FS",	std::make_unique< Dot_S< TForth, FloatType > >( forth_comp, forth_comp.GetOutSink() ), " xf -- xf " );
+			forth_comp.InsertWord_2_Dict( ".SDF",	std::make_unique< Stack_Dump< TForth, FloatType > >( forth_comp, forth_comp.GetOutSink(), Letter_2_Name( kSpace ) ), " x -- x ==> float stack dump " );
+
+
+			// The floating-point values live on their own stack, in their native format
+			forth_comp.InsertWord_2_Dict( "F+",		std::make_unique< ExFloatStackOp< TForth, [] ( auto & fs ) { return fs.template Plus< FloatType >(); }	> >( forth_comp ), " xf yf -- xf+yf " );
+			forth_comp.InsertWord_2_Dict( "F-",		std::make_unique< ExFloatStackOp< TForth, [] ( auto & fs ) { return fs.template Minus< FloatType >(); }	> >( forth_comp ), " xf yf -- xf-yf " );
+			forth_comp.InsertWord_2_Dict( "F*",		std::make_unique< ExFloatStackOp< TForth, [] ( auto & fs ) { return fs.template Mult< FloatType >(); }	> >( forth_comp ), " xf yf -- xf*yf " );
+			forth_comp.InsertWord_2_Dict( "F/",		std::make_unique< ExFloatStackOp< TForth, [] ( auto & fs ) { return fs.template Div< FloatType >(); }		> >( forth_comp ), " xf yf -- xf/yf " );
+
+
+			forth_comp.InsertWord_2_Dict( "FDROP",	std::make_unique< ExFloatStackOp< TForth, [] ( auto & fs ) { return fs.Drop();  }	 > >( forth_comp ), " xf -- " );
+			forth_comp.InsertWord_2_Dict( "FDUP",	std::make_unique< ExFloatStackOp< TForth, [] ( auto & fs ) { return fs.Dup();  }	 > >( forth_comp ), " xf -- xf xf " );
+			forth_comp.InsertWord_2_Dict( "FSWAP",	std::make_unique< ExFloatStackOp< TForth, [] ( auto & fs ) { return fs.Swap();  }	 > >( forth_comp ), " xf yf -- yf xf " );
+			forth_comp.InsertWord_2_Dict( "FOVER",	std::make_unique< ExFloatStackOp< TForth, [] ( auto & fs ) { return fs.Over();  }	 > >( forth_comp ), " xf yf -- xf yf xf " );
+			forth_comp.InsertWord_2_Dict( "FROT",	std::make_unique< ExFloatStackOp< TForth, [] ( auto & fs ) { return fs.Rot();  }	 > >( forth_comp ), " xf yf zf -- yf zf xf " );
+
+			auto & floatStack = forth_comp.GetFloatStack();
+			forth_comp.InsertWord_2_Dict( "FDEPTH",	std::make_unique< StackOp< TForth, CellType > >( forth_comp, [ & floatStack ] () { return static_cast< CellType >( floatStack.size() ); } ), " -- n " );
+			forth_comp.InsertWord_2_Dict( "FCLEAR",	std::make_unique< ExFloatStackOp< TForth, [] ( auto & fs ) { fs.clear(); return true; }	 > >( forth_comp ), " xf ... zf -- " );
+
+
+			// The flags of the comparisons go to the data stack
+			using FloatCmpOp = StackOp< TForth, CellType, FloatType, FloatType >;
+
+			forth_comp.InsertWord_2_Dict( "F=",		std::make_unique< FloatCmpOp >( forth_comp, [] ( const auto x, const auto y ) { return x == y ? kBoolTrue : kBoolFalse; } ), " xf yf -- xf=yf " );
+			forth_comp.InsertWord_2_Dict( "F<>",	std::make_unique< FloatCmpOp >( forth_comp, [] ( const auto x, const auto y ) { return x != y ? kBoolTrue : kBoolFalse; } ), " xf yf -- xf<>yf " );
+			forth_comp.InsertWord_2_Dict( "F<",		std::make_unique< FloatCmpOp >( forth_comp, [] ( const auto x, const auto y ) { return x <  y ? kBoolTrue : kBoolFalse; } ), " xf yf -- xf<yf " );
+			forth_comp.InsertWord_2_Dict( "F<=",	std::make_unique< FloatCmpOp >( forth_comp, [] ( const auto x, const auto y ) { return x <= y ? kBoolTrue : kBoolFalse; } ), " xf yf -- xf<=yf " );
+			forth_comp.InsertWord_2_Dict( "F>",		std::make_unique< FloatCmpOp >( forth_comp, [] ( const auto x, const auto y ) { return x >  y ? kBoolTrue : kBoolFalse; } ), " xf yf -- xf>yf " );
+			forth_comp.InsertWord_2_Dict( "F>=",	std::make_unique< FloatCmpOp >( forth_comp, [] ( const auto x, const auto y ) { return x >= y ? kBoolTrue : kBoolFalse; } ), " xf yf -- xf>=yf " );
+
+
+			// The address goes on the data stack
+			forth_comp.InsertWord_2_Dict( "F@",		std::make_unique< StackOp< TForth, FloatType, CellType > >( forth_comp, [] ( const auto addr ) { return * reinterpret_cast< const FloatType * >( addr ); } ), " addr -- xf " );
+			forth_comp.InsertWord_2_Dict( "F!",		std::make_unique< StackOp< TForth, void, FloatType, CellType > >( forth_comp, [] ( const auto x, const auto addr ) { * reinterpret_cast< FloatType * >( addr ) = x; } ), " xf addr -- " );
+			forth_comp.InsertWord_2_Dict( "F,",		std::make_unique< Comma< TForth, FloatType > >( forth_comp ), " xf -- " );
+
+			DirectTextModule( {	": FLOATS ( n -- n*sizeof(float) ) CELLS ;",		// a float takes one cell
+								": FLOAT+ ( addr -- addr+sizeof(float) ) CELL+ ;",
+								R"(	: FCONSTANT		( xf -- | )		CREATE F,				DOES>	( -- xf )		F@ ;	)",
+								R"(	: FVALUE		( xf -- | )		CREATE F,				DOES>	( -- xf )		F@ ;	)",		// TO knows an FVALUE and takes its value from the float stack
+								R"(	: FVARIABLE		( -- | )		CREATE 1 FLOATS ALLOT	DOES>	( -- addr )		;		)"
+							} )( forth_comp );
+
+
+			using UnaryFloatOp = StackOp< TForth, FloatType, FloatType >;
+			using BinFloatOp = StackOp< TForth, FloatType, FloatType, FloatType >;
+
+			forth_comp.InsertWord_2_Dict( "FNEG",	std::make_unique< UnaryFloatOp >( forth_comp, [] ( const auto x ) { return -x; } ), " x -- -x " );
+
+
+			forth_comp.InsertWord_2_Dict( "SQRT",	std::make_unique< UnaryFloatOp >( forth_comp, [] ( const auto x ) { return std::sqrt( x ); } ), " xf -- sqrt(xf) " );
+			forth_comp.InsertWord_2_Dict( "POW",	std::make_unique< BinFloatOp >( forth_comp, [] ( const auto x, const auto y ) { return std::pow( x, y ); } ), " xf yf -- pow(xf,yf) " );
+
+
+			forth_comp.InsertWord_2_Dict( "SIN",	std::make_unique< UnaryFloatOp >( forth_comp, [] ( const auto x ) { return std::sin( x ); } ), " xf -- sin(xf) " );
+			forth_comp.InsertWord_2_Dict( "COS",	std::make_unique< UnaryFloatOp >( forth_comp, [] ( const auto x ) { return std::cos( x ); } ), " xf -- cos(xf) " );
+			forth_comp.InsertWord_2_Dict( "TAN",	std::make_unique< UnaryFloatOp >( forth_comp, [] ( const auto x ) { return std::tan( x ); } ), " xf -- tan(xf) " );
+			forth_comp.InsertWord_2_Dict( "ATAN",	std::make_unique< UnaryFloatOp >( forth_comp, [] ( const auto x ) { return std::tan( x ); } ), " xf -- atan(xf) " );
+			forth_comp.InsertWord_2_Dict( "ATAN2",	std::make_unique< BinFloatOp >( forth_comp, [] ( const auto x, const auto y ) { return std::atan2( x, y ); } ), " xf yf -- atan2(xf,yf) " );
+
+
+			// Convert int->float, float->int (between the data and the floating-point stacks)
+			forth_comp.InsertWord_2_Dict( "2INT",	std::make_unique< StackOp< TForth, SignedIntType, FloatType > >( forth_comp, [] ( const auto x ) { return static_cast< SignedIntType >( x ); } ), " f -- i " );
+			forth_comp.InsertWord_2_Dict( "2FP",	std::make_unique< StackOp< TForth, FloatType, SignedIntType > >( forth_comp, [] ( const auto x ) { return static_cast< FloatType >( x ); } ), " i -- f " );
+			forth_comp.InsertWord_2_Dict( "F>S",	std::make_unique< StackOp< TForth, SignedIntType, FloatType > >( forth_comp, [] ( const auto x ) { return static_cast< SignedIntType >( x ); } ), " xf -- i " );
+			forth_comp.InsertWord_2_Dict( "S>F",	std::make_unique< StackOp< TForth, FloatType, SignedIntType > >( forth_comp, [] ( const auto x ) { return static_cast< FloatType >( x ); } ), " i -- xf " );
+
+		}
+
+	};
+
+
+
+}
+
+
+
@@ -0,0 +1,224 @@
+// ========================================================================
+//
+// The Forth interpreter-compiler by Prof. Boguslaw Cyganek (C) 2021
+//
+// The software is supplied as is and for educational purposes
+// without any guarantees nor responsibility of its use in any application.
+//
+// ========================================================================
+
+
+#pragma once
+
+
+
+#include "Modules.h"
+#include "MappedFiles.h"
+#include "BufferedFile.h"
+
+
+
+
+namespace BCForth
+{
+
+
+	// --------------------------------------
+	// The words on the files - the File-Access words of the standard, and the mapped files.
+	// The files are the ones of the host, or of the SPIFFS on the ESP32 (e.g. /spiffs/log.txt).
+	// The iors are 0 if OK, e.g.
+	//
+	// : LOG-NAME S" /spiffs/log.txt" ;
+	// : LOG ( c-addr u -- )	LOG-NAME W/O CREATE-FILE DROP >R  R@ WRITE-LINE DROP  R> CLOSE-FILE DROP ;
+	//
+	// A mapped file is seen as a memory region, so all the words
+	// on the memory (@, C@, COMPARE, SEARCH, VSUM, ...) work on it directly, e.g.
+	//
+	// : DATA-FILE S" samples.bin" ;
+	// : CELL-SUM ( c-addr u -- sum )	MAP-FILE DROP 2DUP 8 / VSUM >R UNMAP-FILE DROP R> ;
+	// DATA-FILE CELL-SUM .					\ the sum of the cells in the file (the iors are dropped here)
+	//
+	class FileModule : public TForthModule
+	{
+
+		using StDatType = TForthCompiler::DataStack::value_type;
+
+		using EMapMode = TMappedFiles::EMapMode;
+
+
+		static std::string PathOf( StDatType c_addr, StDatType u ) { return std::string( reinterpret_cast< const char * >( c_addr ), u ); }
+
+		// c-addr u fam -- fileid ior
+		static auto OpenFile( std::shared_ptr< TOpenFiles > files, bool create )
+		{
+			return [ files, create ] ( auto & ds )	{	StDatType c_addr, u, fam;
+														if( ! ( ds.Pop( fam ) && ds.Pop( u ) && ds.Pop( c_addr ) ) ) return false;
+														const auto [ file, ior ] = files->Open( PathOf( c_addr, u ), fam, create );
+														return ds.Push( reinterpret_cast< StDatType >( file ) ) && ds.Push( static_cast< StDatType >( ior ) );
+													};
+		}
+
+		// c-addr u fileid -- ior
+		static auto WriteFile( std::shared_ptr< TOpenFiles > files, bool new_line )
+		{
+			return [ files, new_line ] ( auto & ds )	{	StDatType c_addr, u, fileid;
+															if( ! ( ds.Pop( fileid ) && ds.Pop( u ) && ds.Pop( c_addr ) ) ) return false;
+															auto * file { files->Find( reinterpret_cast< const void * >( fileid ) ) };
+															if( file == nullptr )
+																return ds.Push( static_cast< StDatType >( EBADF ) );
+															int ior { file->Write( reinterpret_cast< const RawByte * >( c_addr ), u ) };
+															if( const RawByte eol { '\n' }; ior == 0 && new_line )
+																ior = file->Write( & eol, 1 );
+															return ds.Push( static_cast< StDatType >( ior ) );
+														};
+		}
+
+		// fileid -- ud ior
+		template < auto Query >
+		static auto FileQuery( std::shared_ptr< TOpenFiles > files )
+		{
+			return [ files ] ( auto & ds )	{	StDatType fileid;
+												if( ! ds.Pop( fileid ) ) return false;
+												auto * file { files->Find( reinterpret_cast< const void * >( fileid ) ) };
+												const auto [ val, ior ] = file != nullptr ? ( file ->* Query )() : std::pair< size_type, int > { 0, EBADF };
+												return ds.Push( val ) && ds.Push( 0 ) && ds.Push( static_cast< StDatType >( ior ) );
+											};
+		}
+
+
+		// c-addr u -- addr len ior
+		static auto MapFile( std::shared_ptr< TMappedFiles > mapped, EMapMode mode )
+		{
+			return [ mapped, mode ] ( auto & ds )	{	StDatType c_addr, u;
+														if( ! ( ds.Pop( u ) && ds.Pop( c_addr ) ) ) return false;
+														const auto res { mapped->Map( PathOf( c_addr, u ), mode ) };
+														return ds.Push( reinterpret_cast< StDatType >( res.fAddr ) ) && ds.Push( res.fLen ) && ds.Push( static_cast< StDatType >( res.fIor ) );
+													};
+		}
+
+	public:
+
+		// Call to upload new words to the forth_comp
+		void operator () ( TForthCompiler & forth_comp ) override
+		{
+			FileAccessOperations( forth_comp );
+			MappedFileOperations( forth_comp );
+		}
+
+
+	private:
+
+
+		// Each open file has its own large buffer, so the small reads and writes (e.g. of the lines)
+		// do not go to the file system one by one. The fileid is the address of the open file.
+		void FileAccessOperations( TForthCompiler & forth_comp )
+		{
+
+			auto files { std::make_shared< TOpenFiles >() };		// the files still open are flushed and closed with the last of the words
+
+			DirectTextModule( {
+
+					std::to_string( TOpenFiles::kReadOnly ) + " CONSTANT R/O",
+					std::to_string( TOpenFiles::kWriteOnly ) + " CONSTANT W/O",
+					std::to_string( TOpenFiles::kReadWrite ) + " CONSTANT R/W",
+					": BIN ( fam -- fam ) " + std::to_string( TOpenFiles::kBinary ) + " OR ;",		// the files are always binary (no conversions)
+
+				} )( forth_comp );
+
+
+			// The file has to exist
+			forth_comp.InsertWord_2_Dict( "OPEN-FILE",		std::make_unique< GenericStackOp< TForth > >( forth_comp, OpenFile( files, false ) ), " c-addr u fam -- fileid ior " );
+
+			// A new file, or the old one made empty
+			forth_comp.InsertWord_2_Dict( "CREATE-FILE",	std::make_unique< GenericStackOp< TForth > >( forth_comp, OpenFile( files, true ) ), " c-addr u fam -- fileid ior " );
+
+			forth_comp.InsertWord_2_Dict( "CLOSE-FILE",		std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[ files ] ( auto & ds )	{	StDatType fileid;
+											return ds.Pop( fileid ) && ds.Push( static_cast< StDatType >( files->Close( reinterpret_cast< const void * >( fileid ) ) ) );
+										}	), " fileid -- ior " );
+
+			forth_comp.InsertWord_2_Dict( "DELETE-FILE",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[] ( auto & ds )	{	StDatType c_addr, u;
+										return ds.Pop( u ) && ds.Pop( c_addr ) && ds.Push( static_cast< StDatType >( std::remove( PathOf( c_addr, u ).c_str() ) == 0 ? 0 : FileIor() ) );
+									}	), " c-addr u -- ior " );
+
+
+			// u2 < u1 only at the end of the file
+			forth_comp.InsertWord_2_Dict( "READ-FILE",		std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[ files ] ( auto & ds )	{	StDatType c_addr, u1, fileid;
+											if( ! ( ds.Pop( fileid ) && ds.Pop( u1 ) && ds.Pop( c_addr ) ) ) return false;
+											auto * file { files->Find( reinterpret_cast< const void * >( fileid ) ) };
+											const auto [ u2, ior ] = file != nullptr ? file->Read( reinterpret_cast< RawByte * >( c_addr ), u1 ) : std::pair< size_type, int > { 0, EBADF };
+											return ds.Push( u2 ) && ds.Push( static_cast< StDatType >( ior ) );
+										}	), " c-addr u1 fileid -- u2 ior " );
+
+			// The line goes from the file buffer straight to c-addr, with no end of line (LF or CR LF).
+			// u2 = u1 if the line is longer - its rest comes with the next READ-LINE. The flag is false at the end of the file.
+			forth_comp.InsertWord_2_Dict( "READ-LINE",		std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[ files ] ( auto & ds )	{	StDatType c_addr, u1, fileid;
+											if( ! ( ds.Pop( fileid ) && ds.Pop( u1 ) && ds.Pop( c_addr ) ) ) return false;
+											auto * file { files->Find( reinterpret_cast< const void * >( fileid ) ) };
+											const auto res { file != nullptr ? file->ReadLine( reinterpret_cast< RawByte * >( c_addr ), u1 ) : TBufferedFile::ReadLineResult { .fIor = EBADF } };
+											return ds.Push( res.fLen ) && ds.Push( res.fFlag ? kBoolTrue : kBoolFalse ) && ds.Push( static_cast< StDatType >( res.fIor ) );
+										}	), " c-addr u1 fileid -- u2 flag ior " );
+
+
+			forth_comp.InsertWord_2_Dict( "WRITE-FILE",		std::make_unique< GenericStackOp< TForth > >( forth_comp, WriteFile( files, false ) ), " c-addr u fileid -- ior " );
+
+			// The line ends with LF
+			forth_comp.InsertWord_2_Dict( "WRITE-LINE",		std::make_unique< GenericStackOp< TForth > >( forth_comp, WriteFile( files, true ) ), " c-addr u fileid -- ior " );
+
+			// The buffered data goes to the file now, e.g. for a log which has to survive a reset
+			forth_comp.InsertWord_2_Dict( "FLUSH-FILE",		std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[ files ] ( auto & ds )	{	StDatType fileid;
+											if( ! ds.Pop( fileid ) ) return false;
+											auto * file { files->Find( reinterpret_cast< const void * >( fileid ) ) };
+											return ds.Push( static_cast< StDatType >( file != nullptr ? file->Flush() : EBADF ) );
+										}	), " fileid -- ior " );
+
+
+			// The sizes and the positions are the unsigned doubles, as in the standard
+			forth_comp.InsertWord_2_Dict( "FILE-SIZE",		std::make_unique< GenericStackOp< TForth > >( forth_comp, FileQuery< & TBufferedFile::Size >( files ) ), " fileid -- ud ior " );
+			forth_comp.InsertWord_2_Dict( "FILE-POSITION",	std::make_unique< GenericStackOp< TForth > >( forth_comp, FileQuery< & TBufferedFile::Position >( files ) ), " fileid -- ud ior " );
+
+			forth_comp.InsertWord_2_Dict( "REPOSITION-FILE",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[ files ] ( auto & ds )	{	StDatType pos, pos_hi, fileid;
+											if( ! ( ds.Pop( fileid ) && ds.Pop( pos_hi ) && ds.Pop( pos ) ) ) return false;
+											auto * file { files->Find( reinterpret_cast< const void * >( fileid ) ) };
+											return ds.Push( static_cast< StDatType >( file == nullptr ? EBADF : pos_hi != 0 ? EINVAL : file->Reposition( pos ) ) );
+										}	), " ud fileid -- ior " );
+
+		}
+
+
+
+		// On the host the file is mapped with mmap - nothing is read until it is touched, so the files can be larger
+		// than the memory. On the ESP32 the whole file (e.g. from /spiffs) is read to a buffer on the heap.
+		void MappedFileOperations( TForthCompiler & forth_comp )
+		{
+
+			auto mapped { std::make_shared< TMappedFiles >() };		// shared by the words, the maps still open are closed with the last of them
+
+			// The memory of the read-only map cannot be written (on the host it ends in the segmentation fault)
+			forth_comp.InsertWord_2_Dict( "MAP-FILE",		std::make_unique< GenericStackOp< TForth > >( forth_comp, MapFile( mapped, EMapMode::kReadOnly ) ), " c-addr u -- addr len ior " );
+
+			// The writes go to the private copies of the pages, never to the file
+			forth_comp.InsertWord_2_Dict( "MAP-FILE-COW",	std::make_unique< GenericStackOp< TForth > >( forth_comp, MapFile( mapped, EMapMode::kCopyOnWrite ) ), " c-addr u -- addr len ior " );
+
+			forth_comp.InsertWord_2_Dict( "UNMAP-FILE",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[ mapped ] ( auto & ds )	{	StDatType addr, len;
+												return ds.Pop( len ) && ds.Pop( addr ) && ds.Push( static_cast< StDatType >( mapped->Unmap( reinterpret_cast< const RawByte * >( addr ), len ) ) );
+											}	), " addr len -- ior " );
+
+		}
+
+
+
+	};
+
+
+
+}
+
+
+
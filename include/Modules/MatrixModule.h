@@ -0,0 +1,197 @@
+// ========================================================================
+//
+// The Forth interpreter-compiler by Prof. Boguslaw Cyganek (C) 2021
+//
+// The software is supplied as is and for educational purposes
+// without any guarantees nor responsibility of its use in any application.
+//
+// ========================================================================
+
+
+#pragma once
+
+
+
+#include "Modules.h"
+#include "VectorKernels.h"
+
+
+
+
+namespace BCForth
+{
+
+
+	// --------------------------------------
+	// The 2D matrices of cells, with the layout of 2ARRAY: [#c,#r][<--- #r*#c ---->], row after row.
+	// A word made by MATRIX gives the address of its element, as 2ARRAY does, e.g.
+	//
+	// 3 4 MATRIX A				\ 3 rows, 4 columns
+	// 7 1 2 A !				\ A(1,2) = 7
+	// ' A >BODY CONSTANT MA	\ the matrix itself, for the words below
+	// MA MA MB MAT+			\ MB = MA + MA
+	//
+	class MatrixModule : public TForthModule
+	{
+
+		using StDatType = TForthCompiler::DataStack::value_type;
+
+		static constexpr StDatType kMatHeaderCells { 2 };		// #c and #r
+
+		struct Matrix
+		{
+			StDatType		fCols {};
+			StDatType		fRows {};
+			StDatType *		fData {};
+		};
+
+		static Matrix GetMatrix( StDatType addr )
+		{
+			auto * p { reinterpret_cast< StDatType * >( addr ) };
+			return Matrix { p[ 0 ], p[ 1 ], p + kMatHeaderCells };
+		}
+
+		static void CheckRow( const Matrix & m, StDatType r )
+		{
+			if( r >= m.fRows )
+				throw ForthError( "Row index out of range" );
+		}
+
+		static void CheckCol( const Matrix & m, StDatType c )
+		{
+			if( c >= m.fCols )
+				throw ForthError( "Col index out of range" );
+		}
+
+		static void CheckDims( bool dims_ok )
+		{
+			if( ! dims_ok )
+				throw ForthError( "matrix dimensions do not match" );
+		}
+
+		static void CheckDistinct( const Matrix & res, const Matrix & m )
+		{
+			if( res.fData == m.fData )
+				throw ForthError( "the result has to go to another matrix" );
+		}
+
+	public:
+
+		// Call to upload new words to the forth_comp
+		void operator () ( TForthCompiler & forth_comp ) override
+		{
+			ElementOperations( forth_comp );
+			MatrixOperations( forth_comp );
+		}
+
+
+	private:
+
+
+		void ElementOperations( TForthCompiler & forth_comp )
+		{
+
+			// With no bounds checks - for the loops which already keep the indices in range
+			forth_comp.InsertWord_2_Dict( "(MAT-ADDR)",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[] ( auto & ds )	{	StDatType r, c, mat;
+										if( ! ( ds.Pop( mat ) && ds.Pop( c ) && ds.Pop( r ) ) ) return false;
+										const auto m { GetMatrix( mat ) };
+										return ds.Push( reinterpret_cast< StDatType >( m.fData + r * m.fCols + c ) );
+									}	), " r c mat -- addr(r,c) " );
+
+			forth_comp.InsertWord_2_Dict( "MAT-ADDR",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[] ( auto & ds )	{	StDatType r, c, mat;
+										if( ! ( ds.Pop( mat ) && ds.Pop( c ) && ds.Pop( r ) ) ) return false;
+										const auto m { GetMatrix( mat ) };
+										CheckRow( m, r ), CheckCol( m, c );
+										return ds.Push( reinterpret_cast< StDatType >( m.fData + r * m.fCols + c ) );
+									}	), " r c mat -- addr(r,c) " );
+
+			forth_comp.InsertWord_2_Dict( "MAT-DIM",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[] ( auto & ds )	{	StDatType mat;
+										if( ! ds.Pop( mat ) ) return false;
+										const auto m { GetMatrix( mat ) };
+										return ds.Push( m.fRows ) && ds.Push( m.fCols );
+									}	), " mat -- #r #c " );
+
+
+			// The row is contiguous, so it goes to the V... words as it is
+			forth_comp.InsertWord_2_Dict( "MAT-ROW",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[] ( auto & ds )	{	StDatType r, mat;
+										if( ! ( ds.Pop( mat ) && ds.Pop( r ) ) ) return false;
+										const auto m { GetMatrix( mat ) };
+										CheckRow( m, r );
+										return ds.Push( reinterpret_cast< StDatType >( m.fData + r * m.fCols ) ) && ds.Push( m.fCols );
+									}	), " r mat -- addr #c " );
+
+			// The elements of a column are stride bytes apart
+			forth_comp.InsertWord_2_Dict( "MAT-COL",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[] ( auto & ds )	{	StDatType c, mat;
+										if( ! ( ds.Pop( mat ) && ds.Pop( c ) ) ) return false;
+										const auto m { GetMatrix( mat ) };
+										CheckCol( m, c );
+										return ds.Push( reinterpret_cast< StDatType >( m.fData + c ) ) && ds.Push( m.fRows ) && ds.Push( m.fCols * sizeof( StDatType ) );
+									}	), " c mat -- addr #r stride " );
+
+		}
+
+
+
+		void MatrixOperations( TForthCompiler & forth_comp )
+		{
+
+			forth_comp.InsertWord_2_Dict( "MAT+",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[] ( auto & ds )	{	StDatType mat1, mat2, mat3;
+										if( ! ( ds.Pop( mat3 ) && ds.Pop( mat2 ) && ds.Pop( mat1 ) ) ) return false;
+										const auto m1 { GetMatrix( mat1 ) }, m2 { GetMatrix( mat2 ) }, m3 { GetMatrix( mat3 ) };
+										CheckDims( m1.fRows == m2.fRows && m1.fCols == m2.fCols && m1.fRows == m3.fRows && m1.fCols == m3.fCols );
+										VecAdd( m1.fData, m2.fData, m3.fData, m1.fRows * m1.fCols );
+										return true;
+									}	), " mat1 mat2 mat3 -- ==> mat3 = mat1 + mat2 " );
+
+			forth_comp.InsertWord_2_Dict( "MAT*",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[] ( auto & ds )	{	StDatType mat1, mat2, mat3;
+										if( ! ( ds.Pop( mat3 ) && ds.Pop( mat2 ) && ds.Pop( mat1 ) ) ) return false;
+										const auto m1 { GetMatrix( mat1 ) }, m2 { GetMatrix( mat2 ) }, m3 { GetMatrix( mat3 ) };
+										CheckDims( m1.fCols == m2.fRows && m3.fRows == m1.fRows && m3.fCols == m2.fCols );
+										CheckDistinct( m3, m1 ), CheckDistinct( m3, m2 );
+										MatMul( m1.fData, m2.fData, m3.fData, m1.fRows, m1.fCols, m2.fCols );
+										return true;
+									}	), " mat1 mat2 mat3 -- ==> mat3 = mat1 * mat2 " );
+
+			forth_comp.InsertWord_2_Dict( "TRANSPOSE",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[] ( auto & ds )	{	StDatType mat1, mat2;
+										if( ! ( ds.Pop( mat2 ) && ds.Pop( mat1 ) ) ) return false;
+										const auto m1 { GetMatrix( mat1 ) }, m2 { GetMatrix( mat2 ) };
+										CheckDims( m2.fRows == m1.fCols && m2.fCols == m1.fRows );
+										CheckDistinct( m2, m1 );
+										MatTranspose( m1.fData, m2.fData, m1.fRows, m1.fCols );
+										return true;
+									}	), " mat1 mat2 -- ==> mat2 = transposed mat1 " );
+
+
+
+			DirectTextModule( {
+
+					// e.g.
+					// 3 4 MATRIX A
+					// 2 3 A ?			\ print A(2,3)
+					// The same as 2ARRAY but the bounds checks and the address are computed by MAT-ADDR
+					R"(	: MATRIX ( #r #c -- | )		CREATE
+									OVER OVER , , * CELLS ALLOT				\\ the dimensions AND the r*c cells \n
+								DOES>	( r c -- addr(r,c) )	MAT-ADDR ;
+					)"
+
+				} )( forth_comp );
+
+		}
+
+
+
+	};
+
+
+
+}
+
+
@@ -0,0 +1,131 @@
+// ========================================================================
+//
+// The Forth interpreter-compiler by Prof. Boguslaw Cyganek (C) 2021
+//
+// The software is supplied as is and for educational purposes
+// without any guarantees nor responsibility of its use in any application.
+//
+// ========================================================================
+
+
+#pragma once
+
+
+
+#include "Modules.h"
+#include <algorithm>
+#include <compare>
+#include <vector>
+
+
+
+
+namespace BCForth
+{
+
+
+	// --------------------------------------
+	// Sorting the arrays in place, given by their address and the number of elements n, e.g.
+	//
+	// 100 ARRAY DATA
+	// 0 DATA 100 SORT						\ ascending, as the signed integers
+	// : DESC ( x1 x2 -- flag ) > ;
+	// 0 DATA 100 ' DESC SORT-BY			\ with any order
+	// 0 DATA 100 17 BSEARCH . .			\ where is 17
+	//
+	class SortModule : public TForthModule
+	{
+
+		using StDatType = TForthCompiler::DataStack::value_type;
+
+		template < typename T >
+		static T * Ptr( StDatType addr ) { return reinterpret_cast< T * >( addr ); }
+
+
+		// The bottom-up merge sort - stable, and with no assumptions on the comparator,
+		// so a Forth comparator which is not a proper order does not make it go out of the array
+		template < typename T, typename Less >
+		static void MergeSort( T * a, size_type n, Less less )
+		{
+			std::vector< T >	buf( n );
+			T * src { a }, * dst { buf.data() };
+
+			for( size_type width { 1 }; width < n; width *= 2 )
+			{
+				for( size_type lo {}; lo < n; lo += 2 * width )
+				{
+					const auto mid { std::min( lo + width, n ) }, hi { std::min( lo + 2 * width, n ) };
+					size_type i { lo }, j { mid }, k { lo };
+					while( i < mid && j < hi )
+						dst[ k ++ ] = less( src[ j ], src[ i ] ) ? src[ j ++ ] : src[ i ++ ];
+					while( i < mid )
+						dst[ k ++ ] = src[ i ++ ];
+					while( j < hi )
+						dst[ k ++ ] = src[ j ++ ];
+				}
+				std::swap( src, dst );
+			}
+
+			if( src != a )
+				std::copy_n( src, n, a );
+		}
+
+	public:
+
+		// Call to upload new words to the forth_comp
+		void operator () ( TForthCompiler & forth_comp ) override
+		{
+
+			// The std::sort is the introsort - the quicksort which turns to the heapsort if it goes badly
+			forth_comp.InsertWord_2_Dict( "SORT",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[] ( auto & ds )	{	StDatType a, n;
+										return ds.Pop( n ) && ds.Pop( a ) ? std::sort( Ptr< SignedIntType >( a ), Ptr< SignedIntType >( a ) + n ), true : false;
+									}	), " a n -- ==> ascending a " );
+
+			// The total order of the IEEE 754, so also the NaNs have their place (at the ends)
+			forth_comp.InsertWord_2_Dict( "FSORT",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[] ( auto & ds )	{	StDatType a, n;
+										return ds.Pop( n ) && ds.Pop( a ) ?
+											std::sort( Ptr< FloatType >( a ), Ptr< FloatType >( a ) + n, [] ( const auto x, const auto y ) { return std::strong_order( x, y ) < 0; } ), true : false;
+									}	), " a n -- ==> ascending a " );
+
+
+			// The xt is a Forth word ( x1 x2 -- flag ) which tells if x1 goes before x2
+			forth_comp.InsertWord_2_Dict( "SORT-BY",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[] ( auto & ds )	{	StDatType a, n, xt;
+										if( ! ( ds.Pop( xt ) && ds.Pop( n ) && ds.Pop( a ) ) ) return false;
+										auto & cmp_wrd { * reinterpret_cast< TWord< TForth > * >( xt ) };
+										MergeSort( Ptr< StDatType >( a ), n, [ & ds, & cmp_wrd ] ( const auto x, const auto y )
+											{
+												StDatType flag {};
+												if( ! ( ds.Push( x ) && ds.Push( y ) ) )
+													throw ForthError( "stack overflow" );
+												cmp_wrd();
+												if( ! ds.Pop( flag ) )
+													throw ForthError( "SORT-BY - no flag from the comparator" );
+												return flag != 0;
+											} );
+										return true;
+									}	), " a n xt -- ==> a in the order of xt ( x1 x2 -- flag ) " );
+
+
+			// In the ascending array - the index of x and true, or the index where x would go and false
+			forth_comp.InsertWord_2_Dict( "BSEARCH",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[] ( auto & ds )	{	StDatType a, n, x;
+										if( ! ( ds.Pop( x ) && ds.Pop( n ) && ds.Pop( a ) ) ) return false;
+										const auto * first { Ptr< const SignedIntType >( a ) };
+										const auto * pos { std::lower_bound( first, first + n, static_cast< SignedIntType >( x ) ) };
+										const bool found { pos != first + n && * pos == static_cast< SignedIntType >( x ) };
+										return ds.Push( static_cast< StDatType >( pos - first ) ) && ds.Push( found ? kBoolTrue : kBoolFalse );
+									}	), " a n x -- index flag " );
+
+		}
+
+
+	};
+
+
+
+}
+
+
@@ -0,0 +1,201 @@
+// ========================================================================
+//
+// The Forth interpreter-compiler by Prof. Boguslaw Cyganek (C) 2021
+//
+// The software is supplied as is and for educational purposes
+// without any guarantees nor responsibility of its use in any application.
+//
+// ========================================================================
+
+
+#pragma once
+
+
+
+#include "Modules.h"
+#include "VectorKernels.h"
+
+
+
+
+namespace BCForth
+{
+
+
+	// --------------------------------------
+	// The words on the whole arrays of cells (V...) or floats (FV...), given by their address and the number of elements n,
+	// such as the buffers made by CREATE ... ALLOT or ARRAY. E.g.
+	//
+	// CREATE X 100 CELLS ALLOT
+	// CREATE Y 100 CELLS ALLOT
+	// X Y Y 100 V+			\ Y = X + Y
+	// X 100 VSUM .
+	//
+	// The output array can be one of the inputs.
+	class VectorModule : public TForthModule
+	{
+
+		using StDatType = TForthCompiler::DataStack::value_type;
+
+		template < typename T >
+		static T * Ptr( StDatType addr ) { return reinterpret_cast< T * >( addr ); }
+
+
+		// a1 a2 a3 n -- , a3[ i ] = a1[ i ] op a2[ i ]
+		template < typename T, auto Kernel >
+		static auto ElementWise( void )
+		{
+			return [] ( auto & ds )	{	StDatType a1, a2, a3, n;
+										return ds.Pop( n ) && ds.Pop( a3 ) && ds.Pop( a2 ) && ds.Pop( a1 ) ? Kernel( Ptr< const T >( a1 ), Ptr< const T >( a2 ), Ptr< T >( a3 ), n ), true : false;
+									};
+		}
+
+		// a1 a2 n -- , a2[ i ] = a1[ 0 ] + ... + a1[ i ]
+		template < typename T >
+		static auto PrefixSum( void )
+		{
+			return [] ( auto & ds )	{	StDatType a1, a2, n;
+										return ds.Pop( n ) && ds.Pop( a2 ) && ds.Pop( a1 ) ? VecPrefixSum( Ptr< const T >( a1 ), Ptr< T >( a2 ), n ), true : false;
+									};
+		}
+
+		static void CheckNotEmpty( StDatType n )
+		{
+			if( n == 0 )
+				throw ForthError( "empty array" );
+		}
+
+	public:
+
+		// Call to upload new words to the forth_comp
+		void operator () ( TForthCompiler & forth_comp ) override
+		{
+			CellOperations( forth_comp );
+			FloatOperations( forth_comp );
+		}
+
+
+	private:
+
+
+		// The cells as the signed integers - the sums and products wrap around, as for + and *
+		void CellOperations( TForthCompiler & forth_comp )
+		{
+
+			forth_comp.InsertWord_2_Dict( "V+",		std::make_unique< GenericStackOp< TForth > >( forth_comp, ElementWise< CellType, VecAdd< CellType > >() ), " a1 a2 a3 n -- ==> a3 = a1 + a2 " );
+			forth_comp.InsertWord_2_Dict( "V-",		std::make_unique< GenericStackOp< TForth > >( forth_comp, ElementWise< CellType, VecSub< CellType > >() ), " a1 a2 a3 n -- ==> a3 = a1 - a2 " );
+			forth_comp.InsertWord_2_Dict( "V*",		std::make_unique< GenericStackOp< TForth > >( forth_comp, ElementWise< CellType, VecMul< CellType > >() ), " a1 a2 a3 n -- ==> a3 = a1 * a2 " );
+
+			forth_comp.InsertWord_2_Dict( "VSCALE",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[] ( auto & ds )	{	StDatType a1, a2, n, k;
+										return ds.Pop( k ) && ds.Pop( n ) && ds.Pop( a2 ) && ds.Pop( a1 ) ? VecScale( Ptr< const CellType >( a1 ), k, Ptr< CellType >( a2 ), n ), true : false;
+									}	), " a1 a2 n k -- ==> a2 = k * a1 " );
+
+
+			forth_comp.InsertWord_2_Dict( "VSUM",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[] ( auto & ds )	{	StDatType a, n;
+										return ds.Pop( n ) && ds.Pop( a ) && ds.Push( VecSum( Ptr< const CellType >( a ), n ) );
+									}	), " a n -- sum " );
+
+			forth_comp.InsertWord_2_Dict( "VDOT",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[] ( auto & ds )	{	StDatType a1, a2, n;
+										return ds.Pop( n ) && ds.Pop( a2 ) && ds.Pop( a1 ) && ds.Push( VecDot( Ptr< const CellType >( a1 ), Ptr< const CellType >( a2 ), n ) );
+									}	), " a1 a2 n -- dot_product " );
+
+
+			forth_comp.InsertWord_2_Dict( "VMIN",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[] ( auto & ds )	{	StDatType a, n;
+										if( ! ( ds.Pop( n ) && ds.Pop( a ) ) ) return false;
+										CheckNotEmpty( n );
+										const auto i { VecExtremeIndex< SignedIntType, false >( Ptr< const SignedIntType >( a ), n ) };
+										return ds.Push( Ptr< const StDatType >( a )[ i ] ) && ds.Push( i );
+									}	), " a n -- min index " );
+
+			forth_comp.InsertWord_2_Dict( "VMAX",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[] ( auto & ds )	{	StDatType a, n;
+										if( ! ( ds.Pop( n ) && ds.Pop( a ) ) ) return false;
+										CheckNotEmpty( n );
+										const auto i { VecExtremeIndex< SignedIntType, true >( Ptr< const SignedIntType >( a ), n ) };
+										return ds.Push( Ptr< const StDatType >( a )[ i ] ) && ds.Push( i );
+									}	), " a n -- max index " );
+
+
+			forth_comp.InsertWord_2_Dict( "VCLAMP",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[] ( auto & ds )	{	StDatType a, n, lo, hi;
+										return ds.Pop( hi ) && ds.Pop( lo ) && ds.Pop( n ) && ds.Pop( a ) ?
+											VecClamp( Ptr< SignedIntType >( a ), n, static_cast< SignedIntType >( lo ), static_cast< SignedIntType >( hi ) ), true : false;
+									}	), " a n lo hi -- ==> lo <= a <= hi " );
+
+
+			forth_comp.InsertWord_2_Dict( "VPREFIX",	std::make_unique< GenericStackOp< TForth > >( forth_comp, PrefixSum< CellType >() ), " a1 a2 n -- ==> a2 = prefix sums of a1 " );
+
+		}
+
+
+
+		// The floats in the arrays, the scalars on the floating-point stack
+		void FloatOperations( TForthCompiler & forth_comp )
+		{
+
+			forth_comp.InsertWord_2_Dict( "FV+",	std::make_unique< GenericStackOp< TForth > >( forth_comp, ElementWise< FloatType, VecAdd< FloatType > >() ), " a1 a2 a3 n -- ==> a3 = a1 + a2 " );
+			forth_comp.InsertWord_2_Dict( "FV-",	std::make_unique< GenericStackOp< TForth > >( forth_comp, ElementWise< FloatType, VecSub< FloatType > >() ), " a1 a2 a3 n -- ==> a3 = a1 - a2 " );
+			forth_comp.InsertWord_2_Dict( "FV*",	std::make_unique< GenericStackOp< TForth > >( forth_comp, ElementWise< FloatType, VecMul< FloatType > >() ), " a1 a2 a3 n -- ==> a3 = a1 * a2 " );
+
+
+			auto & fs = forth_comp.GetFloatStack();
+
+			forth_comp.InsertWord_2_Dict( "FVSCALE",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[ & fs ] ( auto & ds )	{	StDatType a1, a2, n;
+											FloatType k {};
+											return fs.Pop( k ) && ds.Pop( n ) && ds.Pop( a2 ) && ds.Pop( a1 ) ? VecScale( Ptr< const FloatType >( a1 ), k, Ptr< FloatType >( a2 ), n ), true : false;
+										}	), " a1 a2 n -- ( F: k -- ) ==> a2 = k * a1 " );
+
+
+			forth_comp.InsertWord_2_Dict( "FVSUM",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[ & fs ] ( auto & ds )	{	StDatType a, n;
+											return ds.Pop( n ) && ds.Pop( a ) && fs.Push( VecSum( Ptr< const FloatType >( a ), n ) );
+										}	), " a n -- ( F: -- sum ) " );
+
+			forth_comp.InsertWord_2_Dict( "FVDOT",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[ & fs ] ( auto & ds )	{	StDatType a1, a2, n;
+											return ds.Pop( n ) && ds.Pop( a2 ) && ds.Pop( a1 ) && fs.Push( VecDot( Ptr< const FloatType >( a1 ), Ptr< const FloatType >( a2 ), n ) );
+										}	), " a1 a2 n -- ( F: -- dot_product ) " );
+
+
+			forth_comp.InsertWord_2_Dict( "FVMIN",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[ & fs ] ( auto & ds )	{	StDatType a, n;
+											if( ! ( ds.Pop( n ) && ds.Pop( a ) ) ) return false;
+											CheckNotEmpty( n );
+											const auto i { VecExtremeIndex< FloatType, false >( Ptr< const FloatType >( a ), n ) };
+											return fs.Push( Ptr< const FloatType >( a )[ i ] ) && ds.Push( i );
+										}	), " a n -- index ( F: -- min ) " );
+
+			forth_comp.InsertWord_2_Dict( "FVMAX",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[ & fs ] ( auto & ds )	{	StDatType a, n;
+											if( ! ( ds.Pop( n ) && ds.Pop( a ) ) ) return false;
+											CheckNotEmpty( n );
+											const auto i { VecExtremeIndex< FloatType, true >( Ptr< const FloatType >( a ), n ) };
+											return fs.Push( Ptr< const FloatType >( a )[ i ] ) && ds.Push( i );
+										}	), " a n -- index ( F: -- max ) " );
+
+
+			forth_comp.InsertWord_2_Dict( "FVCLAMP",	std::make_unique< GenericStackOp< TForth > >( forth_comp,
+				[ & fs ] ( auto & ds )	{	StDatType a, n;
+											FloatType lo {}, hi {};
+											return fs.Pop( hi ) && fs.Pop( lo ) && ds.Pop( n ) && ds.Pop( a ) ? VecClamp( Ptr< FloatType >( a ), n, lo, hi ), true : false;
+										}	), " a n -- ( F: lo hi -- ) ==> lo <= a <= hi " );
+
+
+			forth_comp.InsertWord_2_Dict( "FVPREFIX",	std::make_unique< GenericStackOp< TForth > >( forth_comp, PrefixSum< FloatType >() ), " a1 a2 n -- ==> a2 = prefix sums of a1 " );
+
+		}
+
+
+
+	};
+
+
+
+}
+
+
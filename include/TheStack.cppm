@@ -1,1270 +1,1061 @@
-// ==========================================================================
-//
-// Software written by Boguslaw Cyganek (C) to be used with the book:
-// INTRODUCTION TO PROGRAMMING WITH C++ FOR ENGINEERS
-// Published by Wiley, 2020
-//
-// The software is supplied as is and for educational purposes
-// without any guarantees nor responsibility of its use in any application. 
-//
-// ==========================================================================
-
-
-
-#pragma once
-
-
-
-#include <cassert>
-#include <array>
-
-
-
-
-namespace BCForth
-{
-
-
-	// ==============================================================================================
-
-
-
-	// Definition of the base stack data structure
-	// If MaxElems <= kArrayLimit, then the std::array will be used;
-	// Otherwise the heap allocation is used.
-	template < typename T, auto MaxElems, auto kArrayLimit = 64 >
-	class TStackFor
-	{
-	public:
-
-		using value_type = T;
-		enum { kMaxSize = MaxElems };
-
-		// Here we need an additional typename
-		using size_type = BCForth::size_type;
-
-	protected:
-
-		size_type							fStackPtr {};		// indicates the first free cell
-
-
-		using StackType			= std::array< value_type, kMaxSize >;
-		using HeapType				= std::unique_ptr< value_type [] >;
-		using StackDataType		= std::conditional_t< MaxElems <= kArrayLimit, StackType, HeapType >;
-
-
-		StackDataType		fData;
-
-	public:
-				
-		[[nodiscard]] constexpr size_type	max_size() const { return kMaxSize; }
-
-		[[nodiscard]] constexpr size_type	size() const { return fStackPtr; }
-
-		[[nodiscard]] constexpr T *			data() { return & fData[ 0 ]; }		// cannot be const if std::array is its data member
-
-		constexpr void						clear() { fStackPtr = 0; }
-
-	public:
-
-		constexpr TStackFor()
-			: fStackPtr( 0 )
-		{
-			if constexpr ( std::is_same_v< StackDataType, HeapType > )
-				fData = std::make_unique< value_type [] >( kMaxSize );
-		}
-
-
-		// We don't need to explicitly disable copying (i.e. the assignment and the copy constructor), 
-		// since std::unique_ptr will force that this class can be moved but not copied
-
-	public:
-
-
-
-		///////////////////////////////////////////////////////////
-		// This function puts an element onto the stack
-		///////////////////////////////////////////////////////////
-		//		
-		// INPUT:
-		//			new_elem - a reference to the element to
-		//				be put. Actually its copy is put onto
-		//				the stack.
-		//		
-		// OUTPUT:
-		//			true - if operation successful,
-		//			false - failure, due to insufficient
-		//				space on the stack (e.g. too many 
-		//				elements)
-		//		
-		// REMARKS:
-		//		
-		//		
-		constexpr bool Push( const value_type & new_elem )
-		{
-			return fStackPtr < kMaxSize ? fData[ fStackPtr ++ ] = new_elem, true : false;
-		}
-
-		// Move semantics version
-		constexpr bool Push( value_type && new_elem )
-		{
-			return fStackPtr < kMaxSize ? fData[ fStackPtr ++ ] = new_elem, true : false;
-		}
-
-
-		///////////////////////////////////////////////////////////
-		// This functions takes and removes an element from the stack
-		///////////////////////////////////////////////////////////
-		//		
-		// INPUT:
-		//			ret_elem - a reference to the object which
-		//				will be copied with a topmost element
-		//				from the stack. Then the topmost element
-		//				is removed from the stack.
-		//		
-		// OUTPUT:
-		//			true - if operation successful,
-		//			false - failure, due to empty stack
-		//		
-		// REMARKS:
-		//		
-		constexpr bool Pop( value_type & ret_elem )
-		{
-			return fStackPtr > 0 ? ret_elem = std::move( fData[ -- fStackPtr ] ), true : false;		// if possible, "steal" from the top object, rather than copy (a fallback still possible)
-		}
-
-
-
-		///////////////////////////////////////////////////////////
-		// This functions copies the topmost element not removing
-		// it from the stack.
-		///////////////////////////////////////////////////////////
-		//		
-		// INPUT:
-		//			ret_elem - a reference to the object which
-		//				will be copied with a topmost element
-		//				from the stack. 
-		//		
-		// OUTPUT:
-		//			true - if operation successful,
-		//			false - failure, due to empty stack
-		//		
-		// REMARKS:
-		//	
-		constexpr bool Peek( value_type & ret_elem ) const
-		{
-			return fStackPtr > 0 ? ret_elem = fData[ fStackPtr - 1 ], true : false;		// here we need a strong copy
-		}
-
-	};
-
-
-
-
-
-
-
-
-
-	// ---------------------------------------------------------------------------------------------
-	// These are time critical operations therefore they are defined as close the stack as possible.
-	// These are implemented in the series of the following mixin classes.
-	// All others can be implemented with the general interface using exlusively Push and Pop.
-
-
-
-
-
-	template < typename Base >
-	class MSystemWordsStackFor : public Base
-	{
-	public:
-
-		using BaseClass = Base;
-
-		using BaseClass::Push;
-		using BaseClass::Pop;
-		using BaseClass::Peek;
-
-	public:
-
-		using T = typename BaseClass::value_type;
-		using typename BaseClass::size_type;
-		using BaseClass::kMaxSize;
-
-	protected:
-
-		using BaseClass::fData;							// kind of a concept, i.e. the base class must have this 
-		using BaseClass::fStackPtr;
-
-	public:
-
-
-		// Forth specific words - defined here for performance
-		constexpr bool Drop()
-		{
-			return fStackPtr > 0 ? -- fStackPtr, true : false;		
-		}
-
-		constexpr bool Dup()
-		{
-			return fStackPtr > 0 ? Push( fData[ fStackPtr - 1 ] ) : false;
-		}
-
-		constexpr bool Over()
-		{
-			return fStackPtr > 1 ? Push( fData[ fStackPtr - 2 ] ) : false;
-		}
-
-		constexpr bool Swap()
-		{
-			if( fStackPtr >= 2 )
-			{
-				auto top { fData[ fStackPtr - 1 ] };
-				fData[ fStackPtr - 1 ] = fData[ fStackPtr - 2 ];
-				fData[ fStackPtr - 2 ] = top;
-				return true;
-			}
-			return false;
-		}
-
-		constexpr bool Rot()
-		{
-			if( fStackPtr >= 3 )
-			{
-				auto top { fData[ fStackPtr - 3 ] };
-				fData[ fStackPtr - 3 ] = fData[ fStackPtr - 2 ];
-				fData[ fStackPtr - 2 ] = fData[ fStackPtr - 1 ];
-				fData[ fStackPtr - 1 ] = top;
-				return true;
-			}
-			return false;
-		}
-
-		constexpr bool Cells()		{ return fStackPtr > 0 ? fData[ fStackPtr - 1 ] *= sizeof( T ), true : false; }
-
-		constexpr bool CellPlus()	{ return fStackPtr > 0 ? fData[ fStackPtr - 1 ] += sizeof( T ), true : false; }
-
-
-
-		// @
-		template < typename Type2Read >
-		constexpr bool ReadAt()
-		{
-			return fStackPtr > 0 ? fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( * reinterpret_cast< Type2Read * >( fData[ fStackPtr - 1 ] ) ), true : false;
-		}
-
-		// !
-		template < typename Type2Write >
-		constexpr bool WriteAt()
-		{
-			return fStackPtr > 1 ? * reinterpret_cast< Type2Write * >( fData[ fStackPtr - 1 ] ) = BlindValueReInterpretation< Type2Write >( fData[ fStackPtr - 2 ] ), fStackPtr -= 2, true : false;
-		}
-
-		// C+!
-		template < typename Type2Write >
-		constexpr bool UpdateAt()
-		{
-			return fStackPtr > 1 ? * reinterpret_cast< Type2Write * >( fData[ fStackPtr - 1 ] ) += BlindValueReInterpretation< Type2Write >( fData[ fStackPtr - 2 ] ), fStackPtr -= 2, true : false;
-		}
-
-
-
-		// 2@
-		// ( addr -- x1 x2 )
-		template < typename Type2Read >
-		constexpr bool DoubleReadAt()
-		{
-			if( fStackPtr < 1 )
-				return false;
-			auto addr = reinterpret_cast< Type2Read * >( fData[ fStackPtr - 1 ] );
-			fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( * addr ++ );	// replace addre with [addr]
-			return Push( BlindValueReInterpretation< T >( * addr ) );					// the higher must be pushed
-		}
-
-		// 2!
-		// ( x1 x2 addr -- )
-		template < typename Type2Write >
-		constexpr bool DoubleWriteAt()
-		{
-			if( fStackPtr < 3 )
-				return false;
-			auto addr = reinterpret_cast< Type2Write * >( fData[ fStackPtr - 1 ] );
-			* addr ++	= BlindValueReInterpretation< Type2Write >( fData[ fStackPtr - 3 ] );
-			* addr		= BlindValueReInterpretation< Type2Write >( fData[ fStackPtr - 2 ] );	// higher word to higher address
-			fStackPtr -= 3;
-			return true;
-		}
-
-
-
-	};
-
-
-
-
-
-
-
-
-	template < typename Base >
-	class MLogicalOpsStackFor : public Base
-	{
-	public:
-
-		using BaseClass = Base;
-
-		using BaseClass::Push;
-		using BaseClass::Pop;
-		using BaseClass::Peek;
-
-	protected:
-
-		using BaseClass::fData;							// kind of a concept, i.e. the base class must have this 
-		using BaseClass::fStackPtr;
-
-
-	public:
-
-		constexpr bool And()	{ return fStackPtr > 1 ? fData[ fStackPtr - 2 ] &= fData[ fStackPtr - 1 ], -- fStackPtr, true : false; }
-		constexpr bool Or()		{ return fStackPtr > 1 ? fData[ fStackPtr - 2 ] |= fData[ fStackPtr - 1 ], -- fStackPtr, true : false; }
-		constexpr bool Xor()	{ return fStackPtr > 1 ? fData[ fStackPtr - 2 ] ^= fData[ fStackPtr - 1 ], -- fStackPtr, true : false; }
-		constexpr bool Neg()	{ return fStackPtr > 0 ? fData[ fStackPtr - 1 ] = ~ fData[ fStackPtr - 1 ], true : false; }
-
-	};
-
-
-
-
-
-
-
-
-
-
-
-	template < typename Base >
-	class MArithmeticOpsStackFor : public Base
-	{
-
-	public:
-
-		using BaseClass = Base;
-
-		using BaseClass::Push;
-		using BaseClass::Pop;
-		using BaseClass::Peek;
-
-	public:
-
-		using T = typename BaseClass::value_type;
-		using typename BaseClass::size_type;
-		using BaseClass::kMaxSize;
-
-	protected:
-
-		using BaseClass::fData;							// kind of a concept, i.e. the base class must have this 
-		using BaseClass::fStackPtr;
-
-
-	public:
-
-
-		template < typename A >
-		constexpr bool Plus()
-		{
-			if( fStackPtr > 1 )
-			{
-				auto top { BlindValueReInterpretation< A >( fData[ -- fStackPtr ] ) };
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) + top );
-				return true;
-			}
-
-			return false;
-		}
-
-		template < typename A >
-		constexpr bool Minus()
-		{
-			if( fStackPtr > 1 )
-			{
-				auto top { BlindValueReInterpretation< A >( fData[ -- fStackPtr ] ) };
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) - top );
-				return true;
-			}
-
-			return false;
-		}
-
-		template < typename A >
-		constexpr bool Mult()
-		{
-			if( fStackPtr > 1 )
-			{
-				auto top { BlindValueReInterpretation< A >( fData[ -- fStackPtr ] ) };
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) * top );
-				return true;
-			}
-
-			return false;
-		}
-
-		template < typename A >
-		constexpr bool Div()
-		{
-			if( fStackPtr > 1 )
-			{
-				auto top { BlindValueReInterpretation< A >( fData[ -- fStackPtr ] ) };
-				if( top == A( 0 ) )
-					throw ForthError( "div by 0" );
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) / top );
-				return true;
-			}
-
-			return false;
-		}
-
-		template < typename A >
-		constexpr bool Mod()
-		{
-			if( fStackPtr > 1 )
-			{
-				auto top { BlindValueReInterpretation< A >( fData[ -- fStackPtr ] ) };
-				if( top == A( 0 ) )
-					throw ForthError( "div by 0" );
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) % top );
-				return true;
-			}
-
-			return false;
-		}
-
-	public:
-
-
-		// Be careful - the returned value indicates a success of an operation, which is true if there is enough data on the stack
-		// However, the comparison result goes to the topmost cell of the stack !! (i.e. this is NOT what is returned!)
-
-		template < typename A >
-		constexpr bool EQ()
-		{
-			if( fStackPtr > 1 )
-			{
-				auto top { BlindValueReInterpretation< A >( fData[ -- fStackPtr ] ) };
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) == top ? kBoolTrue : kBoolFalse;
-				return true;
-			}
-
-			return false;
-		}
-
-		template < typename A >
-		constexpr bool NE() 
-		{
-			if( fStackPtr > 1 )
-			{
-				auto top { BlindValueReInterpretation< A >( fData[ -- fStackPtr ] ) };
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) != top ? kBoolTrue : kBoolFalse;
-				return true;
-			}
-
-			return false;
-		}
-
-		template < typename A >
-		constexpr bool LT() 
-		{
-			if( fStackPtr > 1 )
-			{
-				auto top { BlindValueReInterpretation< A >( fData[ -- fStackPtr ] ) };
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) < top ? kBoolTrue : kBoolFalse;
-				return true;
-			}
-
-			return false;
-		}
-
-		template < typename A >
-		constexpr bool LE()
-		{
-			if( fStackPtr > 1 )
-			{
-				auto top { BlindValueReInterpretation< A >( fData[ -- fStackPtr ] ) };
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) <= top ? kBoolTrue : kBoolFalse;
-				return true;
-			}
-
-			return false;
-		}
-
-		template < typename A >
-		constexpr bool GT()
-		{
-			if( fStackPtr > 1 )
-			{
-				auto top { BlindValueReInterpretation< A >( fData[ -- fStackPtr ] ) };
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) > top ? kBoolTrue : kBoolFalse;
-				return true;
-			}
-
-			return false;
-		}
-
-		template < typename A >
-		constexpr bool GE()
-		{
-			if( fStackPtr > 1 )
-			{
-				auto top { BlindValueReInterpretation< A >( fData[ -- fStackPtr ] ) };
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) >= top ? kBoolTrue : kBoolFalse;
-				return true;
-			}
-
-			return false;
-		}
-
-
-
-
-		// Spec for 0
-
-		template < typename A >
-		constexpr bool EQ_0()
-		{
-			if( fStackPtr > 0 )
-			{
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) == static_cast< A >( 0 ) ? kBoolTrue : kBoolFalse;
-				return true;
-			}
-
-			return false;
-		}
-
-		template < typename A >
-		constexpr bool NE_0()
-		{
-			if( fStackPtr > 0 )
-			{
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) != static_cast< A >( 0 ) ? kBoolTrue : kBoolFalse;
-				return true;
-			}
-
-			return false;
-		}
-
-		template < typename A >
-		constexpr bool GT_0()
-		{
-			if( fStackPtr > 0 )
-			{
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) > static_cast< A >( 0 ) ? kBoolTrue : kBoolFalse;
-				return true;
-			}
-
-			return false;
-		}
-
-		template < typename A >
-		constexpr bool GE_0()
-		{
-			if( fStackPtr > 0 )
-			{
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) >= static_cast< A >( 0 ) ? kBoolTrue : kBoolFalse;
-				return true;
-			}
-
-			return false;
-		}
-
-		template < typename A >
-		constexpr bool LT_0()
-		{
-			if( fStackPtr > 0 )
-			{
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) < static_cast< A >( 0 ) ? kBoolTrue : kBoolFalse;
-				return true;
-			}
-
-			return false;
-		}
-
-		template < typename A >
-		constexpr bool LE_0()
-		{
-			if( fStackPtr > 0 )
-			{
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) <= static_cast< A >( 0 ) ? kBoolTrue : kBoolFalse;
-				return true;
-			}
-
-			return false;
-		}
-
-
-
-	public:
-
-		// Forth extras - here for speed-up
-
-		template < typename A >
-		constexpr bool OnePlus()
-		{
-			return  fStackPtr > 0 ? fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) + static_cast< A >( 1 ) ), true : false;
-		}
-
-		template < typename A >
-		constexpr bool OneMinus()
-		{
-			return  fStackPtr > 0 ? fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) - static_cast< A >( 1 ) ), true : false;
-		}
-
-		template < typename A >
-		constexpr bool TwoPlus()
-		{
-			return  fStackPtr > 0 ? fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) + static_cast< A >( 2 ) ), true : false;
-		}
-
-		template < typename A >
-		constexpr bool TwoMinus()
-		{
-			return  fStackPtr > 0 ? fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) - static_cast< A >( 2 ) ), true : false;
-		}
-
-		template < typename A >
-		constexpr bool TwoTimes()
-		{
-			return  fStackPtr > 0 ? fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) + BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) ), true : false;
-		}
-
-
-	};
-
-
-
-
-
-
-
-
-	// Assembly them all together 
-	template < typename T, auto MaxElems >
-	using ForthStackFor = MSystemWordsStackFor< MLogicalOpsStackFor< MArithmeticOpsStackFor< TStackFor< T, MaxElems > > > >;
-
-
-
-
-#if OLD
-
-	// xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx
-	// A simplified version taking advantage of w wrap around
-	// properties of the unsigned integers
-
-
-	// Definition of the base stack data structure
-	template < typename T, typename PtrType = unsigned char >
-	class TFastStackFor
-	{
-	public:
-
-		using value_type = T;
-
-		// Here we need an additional typename
-		using size_type = PtrType; //BCForth::size_type;
-		static_assert( std::is_unsigned_v< size_type > );
-
-		enum { kMaxSize = 1 << sizeof( size_type ) * 8 };
-
-	protected:
-
-		size_type							fStackPtr {};		// indicates the first free cell
-
-		//std::unique_ptr< value_type[] >	fData;
-		std::array< value_type, kMaxSize >	fData;
-
-
-	public:
-
-		constexpr size_type max_size() const { return kMaxSize; }
-
-
-		constexpr size_type size() const { return fStackPtr; }
-
-
-		constexpr T * data() /*const*/ { return & fData[ 0 ]; }
-
-
-		constexpr void clear() { fStackPtr = 0; }
-
-
-	//public:
-
-		//constexpr TFastStackFor()
-		//	: fStackPtr( 0 )
-		//{
-			//fData = std::make_unique< value_type[] >(kMaxSize);
-		//}
-
-
-		// We don't need to explicitly disable copying (i.e. the assignment and the copy constructor), 
-		// since std::unique_ptr will force that this class can be moved but not copied
-
-	public:
-
-
-
-		///////////////////////////////////////////////////////////
-		// This function puts an element onto the stack
-		///////////////////////////////////////////////////////////
-		//		
-		// INPUT:
-		//			new_elem - a reference to the element to
-		//				be put. Actually its copy is put onto
-		//				the stack.
-		//		
-		// OUTPUT:
-		//			true - if operation successful,
-		//			false - failure, due to insufficient
-		//				space on the stack (e.g. too many 
-		//				elements)
-		//		
-		// REMARKS:
-		//		
-		//		
-		constexpr bool Push( const value_type & new_elem )
-		{
-			//return fStackPtr < kMaxSize ? fData[fStackPtr++] = new_elem, true : false;
-			fData[ fStackPtr ++ ] = new_elem;
-			return true;
-		}
-
-		// Move semantics version
-		constexpr bool Push( value_type && new_elem )
-		{
-			//return fStackPtr < kMaxSize ? fData[fStackPtr++] = new_elem, true : false;
-			fData[ fStackPtr ++ ] = std::move( new_elem );
-			return true;
-		}
-
-
-		///////////////////////////////////////////////////////////
-		// This functions takes and removes an element from the stack
-		///////////////////////////////////////////////////////////
-		//		
-		// INPUT:
-		//			ret_elem - a reference to the object which
-		//				will be copied with a topmost element
-		//				from the stack. Then the topmost element
-		//				is removed from the stack.
-		//		
-		// OUTPUT:
-		//			true - if operation successful,
-		//			false - failure, due to empty stack
-		//		
-		// REMARKS:
-		//		
-		constexpr bool Pop( value_type & ret_elem )
-		{
-			//return fStackPtr > 0 ? ret_elem = std::move(fData[--fStackPtr]), true : false;		// if possible, "steal" from the top object, rather than copy (a fallback still possible)
-			ret_elem = std::move( fData[ -- fStackPtr ] );
-			return true;
-		}
-
-
-
-		///////////////////////////////////////////////////////////
-		// This functions copies the topmost element not removing
-		// it from the stack.
-		///////////////////////////////////////////////////////////
-		//		
-		// INPUT:
-		//			ret_elem - a reference to the object which
-		//				will be copied with a topmost element
-		//				from the stack. 
-		//		
-		// OUTPUT:
-		//			true - if operation successful,
-		//			false - failure, due to empty stack
-		//		
-		// REMARKS:
-		//	
-		constexpr bool Peek( value_type & ret_elem ) const
-		{
-			//return fStackPtr > 0 ? ret_elem = fData[fStackPtr - 1], true : false;		// here we need a strong copy
-			ret_elem = fData[ fStackPtr - 1 ];		// always a copy 
-			return true;
-		}
-
-	};
-
-
-
-
-
-	// ---------------------------------------------------------------------------------------------
-	// These are time critical operations therefore they are defined as close the stack as possible.
-	// These are implemented in the series of the following mixin classes.
-	// All others can be implemented with the general interface using exlusively Push and Pop.
-
-
-
-
-
-	template < typename Base >
-	class MSystemWordsStackFor : public Base
-	{
-	public:
-
-		using BaseClass = Base;
-
-		using BaseClass::Push;
-		using BaseClass::Pop;
-		using BaseClass::Peek;
-
-	public:
-
-		using T = typename BaseClass::value_type;
-		using typename BaseClass::size_type;
-		//using BaseClass::kMaxSize;
-
-	protected:
-
-		using BaseClass::fData;							// kind of a concept, i.e. the base class must have this 
-		using BaseClass::fStackPtr;
-
-	public:
-
-
-		// Forth specific words - defined here for performance
-		constexpr bool Drop()
-		{
-			return /*fStackPtr > 0 ?*/ -- fStackPtr, true /*: false*/;		
-		}
-
-		constexpr bool Dup()
-		{
-			return /*fStackPtr > 0 ?*/ Push( fData[ fStackPtr - 1 ] ) /*: false*/;
-		}
-
-		constexpr bool Over()
-		{
-			return /*fStackPtr > 1 ?*/ Push( fData[ fStackPtr - 2 ] ) /*: false*/;
-		}
-
-		constexpr bool Swap() /*const*/
-		{
-			//if( fStackPtr >= 2 )
-			//{
-				auto top { fData[ fStackPtr - 1 ] };
-				fData[ fStackPtr - 1 ] = fData[ fStackPtr - 2 ];
-				fData[ fStackPtr - 2 ] = top;
-				return true;
-			//}
-			//return false;
-		}
-
-		constexpr bool Rot() /*const*/
-		{
-			//if( fStackPtr >= 3 )
-			//{
-				auto top { fData[ fStackPtr - 3 ] };
-				fData[ fStackPtr - 3 ] = fData[ fStackPtr - 2 ];
-				fData[ fStackPtr - 2 ] = fData[ fStackPtr - 1 ];
-				fData[ fStackPtr - 1 ] = top;
-				return true;
-			//}
-			//return false;
-		}
-
-		constexpr bool Cells()		{ return /*fStackPtr > 0 ?*/ fData[ fStackPtr - 1 ] *= sizeof( T ), true /*: false*/; }
-
-		constexpr bool CellPlus()	{ return /*fStackPtr > 0 ?*/ fData[ fStackPtr - 1 ] += sizeof( T ), true /*: false*/; }
-
-
-
-		// @
-		template < typename Type2Read >
-		constexpr bool ReadAt()
-		{
-			return /*fStackPtr > 0 ?*/ fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( * reinterpret_cast< Type2Read * >( fData[ fStackPtr - 1 ] ) ), true /*: false*/;
-		}
-
-		// !
-		template < typename Type2Write >
-		constexpr bool WriteAt()
-		{
-			return /*fStackPtr > 1 ?*/ * reinterpret_cast< Type2Write * >( fData[ fStackPtr - 1 ] ) = BlindValueReInterpretation< Type2Write >( fData[ fStackPtr - 2 ] ), fStackPtr -= 2, true /*: false*/;
-		}
-
-		// C+!
-		template < typename Type2Write >
-		constexpr bool UpdateAt()
-		{
-			return /*fStackPtr > 1 ?*/ * reinterpret_cast< Type2Write * >( fData[ fStackPtr - 1 ] ) += BlindValueReInterpretation< Type2Write >( fData[ fStackPtr - 2 ] ), fStackPtr -= 2, true /*: false*/;
-		}
-
-
-	};
-
-
-
-
-
-
-
-
-	template < typename Base >
-	class MLogicalOpsStackFor : public Base
-	{
-	public:
-
-		using BaseClass = Base;
-
-		using BaseClass::Push;
-		using BaseClass::Pop;
-		using BaseClass::Peek;
-
-	protected:
-
-		using BaseClass::fData;							// kind of a concept, i.e. the base class must have this 
-		using BaseClass::fStackPtr;
-
-
-	public:
-
-		constexpr bool And()	{ return /*fStackPtr > 1 ?*/ fData[ fStackPtr - 2 ] &= fData[ fStackPtr - 1 ], -- fStackPtr, true /*: false*/; }
-		constexpr bool Or()		{ return /*fStackPtr > 1 ?*/ fData[ fStackPtr - 2 ] |= fData[ fStackPtr - 1 ], -- fStackPtr, true /*: false*/; }
-		constexpr bool Xor()	{ return /*fStackPtr > 1 ?*/ fData[ fStackPtr - 2 ] ^= fData[ fStackPtr - 1 ], -- fStackPtr, true /*: false*/; }
-		constexpr bool Neg()	{ return /*fStackPtr > 0 ?*/ fData[ fStackPtr - 1 ] = ~ fData[ fStackPtr - 1 ], true /*: false*/; }
-
-	};
-
-
-
-
-
-
-
-
-
-
-
-	template < typename Base >
-	class MArithmeticOpsStackFor : public Base
-	{
-
-	public:
-
-		using BaseClass = Base;
-
-		using BaseClass::Push;
-		using BaseClass::Pop;
-		using BaseClass::Peek;
-
-	public:
-
-		using T = typename BaseClass::value_type;
-		using typename BaseClass::size_type;
-		//using BaseClass::kMaxSize;
-
-	protected:
-
-		using BaseClass::fData;							// kind of a concept, i.e. the base class must have this 
-		using BaseClass::fStackPtr;
-
-
-	public:
-
-
-		template < typename A >
-		constexpr bool Plus()
-		{
-			//if( fStackPtr > 1 )
-			//{
-				auto top { BlindValueReInterpretation< A >( fData[ -- fStackPtr ] ) };
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) + top );
-				return true;
-			//}
-
-			//return false;
-		}
-
-		template < typename A >
-		constexpr bool Minus()
-		{
-			//if( fStackPtr > 1 )
-			//{
-				auto top { BlindValueReInterpretation< A >( fData[ -- fStackPtr ] ) };
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) - top );
-				return true;
-			//}
-
-			//return false;
-		}
-
-		template < typename A >
-		constexpr bool Mult()
-		{
-			//if( fStackPtr > 1 )
-			//{
-				auto top { BlindValueReInterpretation< A >( fData[ -- fStackPtr ] ) };
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) * top );
-				return true;
-			//}
-
-			//return false;
-		}
-
-		template < typename A >
-		constexpr bool Div()
-		{
-			//if( fStackPtr > 1 )
-			//{
-				auto top { BlindValueReInterpretation< A >( fData[ -- fStackPtr ] ) };
-				if( top == A( 0 ) )
-					throw ForthError( "div by 0" );
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) / top );
-				return true;
-			//}
-
-			//return false;
-		}
-
-		template < typename A >
-		constexpr bool Mod()
-		{
-			//if( fStackPtr > 1 )
-			//{
-				auto top { BlindValueReInterpretation< A >( fData[ -- fStackPtr ] ) };
-				if( top == A( 0 ) )
-					throw ForthError( "div by 0" );
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) % top );
-				return true;
-			//}
-
-			//return false;
-		}
-
-	public:
-
-
-		// Be careful - the returned value indicates a success of an operation, which is true if there is enough data on the stack
-		// However, the comparison result goes to the topmost cell of the stack !! (i.e. this is NOT what is returned!)
-
-		template < typename A >
-		constexpr bool EQ()
-		{
-			//if( fStackPtr > 1 )
-			//{
-				auto top { BlindValueReInterpretation< A >( fData[ -- fStackPtr ] ) };
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) == top ? kBoolTrue : kBoolFalse;
-				return true;
-			//}
-
-			//return false;
-		}
-
-		template < typename A >
-		constexpr bool NE() 
-		{
-			//if( fStackPtr > 1 )
-			//{
-				auto top { BlindValueReInterpretation< A >( fData[ -- fStackPtr ] ) };
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) != top ? kBoolTrue : kBoolFalse;
-				return true;
-			//}
-
-			//return false;
-		}
-
-		template < typename A >
-		constexpr bool LT() 
-		{
-			//if( fStackPtr > 1 )
-			//{
-				auto top { BlindValueReInterpretation< A >( fData[ -- fStackPtr ] ) };
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) < top ? kBoolTrue : kBoolFalse;
-				return true;
-			//}
-
-			//return false;
-		}
-
-		template < typename A >
-		constexpr bool LE()
-		{
-			//if( fStackPtr > 1 )
-			//{
-				auto top { BlindValueReInterpretation< A >( fData[ -- fStackPtr ] ) };
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) <= top ? kBoolTrue : kBoolFalse;
-				return true;
-			//}
-
-			//return false;
-		}
-
-		template < typename A >
-		constexpr bool GT()
-		{
-			//if( fStackPtr > 1 )
-			//{
-				auto top { BlindValueReInterpretation< A >( fData[ -- fStackPtr ] ) };
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) > top ? kBoolTrue : kBoolFalse;
-				return true;
-			//}
-
-			//return false;
-		}
-
-		template < typename A >
-		constexpr bool GE()
-		{
-			//if( fStackPtr > 1 )
-			//{
-				auto top { BlindValueReInterpretation< A >( fData[ -- fStackPtr ] ) };
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) >= top ? kBoolTrue : kBoolFalse;
-				return true;
-			//}
-
-			//return false;
-		}
-
-
-
-
-		// Spec for 0
-
-		template < typename A >
-		constexpr bool EQ_0()
-		{
-			//if( fStackPtr > 0 )
-			//{
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) == static_cast< A >( 0 ) ? kBoolTrue : kBoolFalse;
-				return true;
-			//}
-
-			//return false;
-		}
-
-		template < typename A >
-		constexpr bool NE_0()
-		{
-			//if( fStackPtr > 0 )
-			//{
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) != static_cast< A >( 0 ) ? kBoolTrue : kBoolFalse;
-				return true;
-			//}
-
-			//return false;
-		}
-
-		template < typename A >
-		constexpr bool GT_0()
-		{
-			//if( fStackPtr > 0 )
-			//{
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) > static_cast< A >( 0 ) ? kBoolTrue : kBoolFalse;
-				return true;
-			//}
-
-			//return false;
-		}
-
-		template < typename A >
-		constexpr bool GE_0()
-		{
-			//if( fStackPtr > 0 )
-			//{
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) >= static_cast< A >( 0 ) ? kBoolTrue : kBoolFalse;
-				return true;
-			//}
-
-			//return false;
-		}
-
-		template < typename A >
-		constexpr bool LT_0()
-		{
-			//if( fStackPtr > 0 )
-			//{
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) < static_cast< A >( 0 ) ? kBoolTrue : kBoolFalse;
-				return true;
-			//}
-
-			//return false;
-		}
-
-		template < typename A >
-		constexpr bool LE_0()
-		{
-			//if( fStackPtr > 0 )
-			//{
-				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) <= static_cast< A >( 0 ) ? kBoolTrue : kBoolFalse;
-				return true;
-			//}
-
-			//return false;
-		}
-
-
-
-	public:
-
-		// Forth extras - here for speed-up
-
-		template < typename A >
-		constexpr bool OnePlus()
-		{
-			return  /*fStackPtr > 0 ?*/ fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) + static_cast< A >( 1 ) ), true /*: false*/;
-		}
-
-		template < typename A >
-		constexpr bool OneMinus()
-		{
-			return  /*fStackPtr > 0 ?*/ fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) - static_cast< A >( 1 ) ), true /*: false*/;
-		}
-
-		template < typename A >
-		constexpr bool TwoPlus()
-		{
-			return  /*fStackPtr > 0 ?*/ fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) + static_cast< A >( 2 ) ), true /*: false*/;
-		}
-
-		template < typename A >
-		constexpr bool TwoMinus()
-		{
-			return  /*fStackPtr > 0 ?*/ fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) - static_cast< A >( 2 ) ), true /*: false*/;
-		}
-
-		template < typename A >
-		constexpr bool TwoTimes()
-		{
-			return  /*fStackPtr > 0 ?*/ fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) + BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) ), true /*: false*/;
-		}
-
-
-	};
-
-
-
-
-
-
-
-
-	// Assembly them all together 
-	template < typename T, typename PtrType >
-	using ForthStackFor = MSystemWordsStackFor< MLogicalOpsStackFor< MArithmeticOpsStackFor< TFastStackFor< T, PtrType > > > >;
-
-#endif
-
-
-}		// End of the BCForth namespace
-
-
-
-
-
-
-// ----------------------------------------------------
-
-
+// ==========================================================================
+//
+// Software written by Boguslaw Cyganek (C) to be used with the book:
+// INTRODUCTION TO PROGRAMMING WITH C++ FOR ENGINEERS
+// Published by Wiley, 2020
+//
+// The software is supplied as is and for educational purposes
+// without any guarantees nor responsibility of its use in any application. 
+//
+// ==========================================================================
+
+
+
+#pragma once
+
+
+
+#include <cassert>
+#include <array>
+#include <memory>
+#include <algorithm>
+
+
+#include "BaseDefinitions.h"
+
+
+
+
+namespace BCForth
+{
+
+
+	// ==============================================================================================
+
+
+
+	// Definition of the base stack data structure
+	// If MaxElems <= kArrayLimit, then the std::array will be used;
+	// Otherwise the heap allocation is used.
+	template < typename T, auto MaxElems, auto kArrayLimit = 64 >
+	class TStackFor
+	{
+	public:
+
+		using value_type = T;
+		enum { kMaxSize = MaxElems };
+
+		// Here we need an additional typename
+		using size_type = BCForth::size_type;
+
+	protected:
+
+		size_type							fStackPtr {};		// indicates the first free cell
+
+
+		using StackType			= std::array< value_type, kMaxSize >;
+		using HeapType				= std::unique_ptr< value_type [] >;
+		using StackDataType		= std::conditional_t< MaxElems <= kArrayLimit, StackType, HeapType >;
+
+
+		StackDataType		fData;
+
+	public:
+				
+		[[nodiscard]] constexpr size_type	max_size() const { return kMaxSize; }
+
+		[[nodiscard]] constexpr size_type	size() const { return fStackPtr; }
+
+		[[nodiscard]] constexpr T *			data() { return & fData[ 0 ]; }		// cannot be const if std::array is its data member
+
+		constexpr void						clear() { fStackPtr = 0; }
+
+		// True if there are at least n elements on the stack
+		[[nodiscard]] constexpr bool		Has( size_type n ) const { return fStackPtr >= n; }
+
+	public:
+
+		constexpr TStackFor()
+			: fStackPtr( 0 )
+		{
+			if constexpr ( std::is_same_v< StackDataType, HeapType > )
+				fData = std::make_unique< value_type [] >( kMaxSize );
+		}
+
+
+		// We don't need to explicitly disable copying (i.e. the assignment and the copy constructor), 
+		// since std::unique_ptr will force that this class can be moved but not copied
+
+	public:
+
+
+
+		///////////////////////////////////////////////////////////
+		// This function puts an element onto the stack
+		///////////////////////////////////////////////////////////
+		//		
+		// INPUT:
+		//			new_elem - a reference to the element to
+		//				be put. Actually its copy is put onto
+		//				the stack.
+		//		
+		// OUTPUT:
+		//			true - if operation successful,
+		//			false - failure, due to insufficient
+		//				space on the stack (e.g. too many 
+		//				elements)
+		//		
+		// REMARKS:
+		//		
+		//		
+		constexpr bool Push( const value_type & new_elem )
+		{
+			return fStackPtr < kMaxSize ? fData[ fStackPtr ++ ] = new_elem, true : false;
+		}
+
+		// Move semantics version
+		constexpr bool Push( value_type && new_elem )
+		{
+			return fStackPtr < kMaxSize ? fData[ fStackPtr ++ ] = new_elem, true : false;
+		}
+
+
+		///////////////////////////////////////////////////////////
+		// This functions takes and removes an element from the stack
+		///////////////////////////////////////////////////////////
+		//		
+		// INPUT:
+		//			ret_elem - a reference to the object which
+		//				will be copied with a topmost element
+		//				from the stack. Then the topmost element
+		//				is removed from the stack.
+		//		
+		// OUTPUT:
+		//			true - if operation successful,
+		//			false - failure, due to empty stack
+		//		
+		// REMARKS:
+		//		
+		constexpr bool Pop( value_type & ret_elem )
+		{
+			return fStackPtr > 0 ? ret_elem = std::move( fData[ -- fStackPtr ] ), true : false;		// if possible, "steal" from the top object, rather than copy (a fallback still possible)
+		}
+
+
+
+		///////////////////////////////////////////////////////////
+		// This functions copies the topmost element not removing
+		// it from the stack.
+		///////////////////////////////////////////////////////////
+		//		
+		// INPUT:
+		//			ret_elem - a reference to the object which
+		//				will be copied with a topmost element
+		//				from the stack. 
+		//		
+		// OUTPUT:
+		//			true - if operation successful,
+		//			false - failure, due to empty stack
+		//		
+		// REMARKS:
+		//	
+		constexpr bool Peek( value_type & ret_elem ) const
+		{
+			return fStackPtr > 0 ? ret_elem = fData[ fStackPtr - 1 ], true : false;		// here we need a strong copy
+		}
+
+	};
+
+
+
+
+
+
+
+
+
+	// The stack with its size set at run-time, e.g. for each Forth instance.
+	// If max_capacity is greater than capacity, then the stack grows (doubling its size) up to max_capacity.
+	//
+	// The stack cells are surrounded by the guard cells with a known pattern. Nothing in the stack
+	// operations writes there, so a changed guard cell means that the stack memory was overwritten
+	// (e.g. by a wrong address in !). Call CheckGuards() at a safe point to detect this.
+	//
+	// The StackCheck policy tells how the underflow is checked (see EStackCheck). The Push always checks
+	// for space, since this is also where the stack grows. 
+	template < typename T, EStackCheck StackCheck = EStackCheck::kChecked >
+	class TDynStackFor
+	{
+	public:
+
+		using value_type = T;
+
+		using size_type = BCForth::size_type;
+
+		static constexpr size_type kGuardCells { 4 };		// on each side
+
+	protected:
+
+		size_type							fStackPtr {};		// indicates the first free cell
+
+		T *									fData {};			// the first stack cell, just after the lower guard cells
+
+	private:
+
+		std::unique_ptr< value_type [] >	fBuffer;			// the guard cells, the stack cells, the guard cells
+
+		size_type							fCapacity {};
+		size_type							fMaxCapacity {};
+
+		static constexpr value_type			kGuardVal { static_cast< value_type >( 0x5AFEC0DE ) };
+
+	private:
+
+		void Allocate( size_type capacity )
+		{
+			auto new_buffer { std::make_unique< value_type [] >( capacity + 2 * kGuardCells ) };
+			auto * new_data { new_buffer.get() + kGuardCells };
+			if( fData != nullptr )
+				std::copy_n( fData, fStackPtr, new_data );
+
+			fBuffer = std::move( new_buffer );
+			fData = new_data;
+			fCapacity = capacity;
+			RestoreGuards();
+		}
+
+		bool Grow( void )
+		{
+			if( fCapacity >= fMaxCapacity )
+				return false;
+
+			Allocate( std::min( fMaxCapacity, 2 * fCapacity + 1 ) );
+			return true;
+		}
+
+	public:
+
+		TDynStackFor( size_type capacity = 64, size_type max_capacity = 0 )
+			: fMaxCapacity( std::max( capacity, max_capacity ) )
+		{
+			Allocate( capacity );
+		}
+
+		TDynStackFor( TDynStackFor && ) = default;
+		TDynStackFor & operator = ( TDynStackFor && ) = default;
+
+	public:
+
+		[[nodiscard]] size_type		max_size() const { return fCapacity; }
+
+		[[nodiscard]] size_type		size() const { return fStackPtr; }
+
+		[[nodiscard]] T *				data() { return fData; }			// can change if the stack grows
+
+		void							clear() { fStackPtr = 0; }
+
+		// True if there are at least n elements on the stack - this is the only underflow check of all the operations
+		[[nodiscard]] constexpr bool	Has( size_type n ) const
+		{
+			if constexpr( StackCheck == EStackCheck::kChecked )
+				return fStackPtr >= n;
+
+			if constexpr( StackCheck == EStackCheck::kDebugChecked )
+				assert( fStackPtr >= n );
+
+			return true;
+		}
+
+		// Drop all the elements above the first new_size ones
+		void							truncate( size_type new_size ) { fStackPtr = std::min( fStackPtr, new_size ); }
+
+		[[nodiscard]] bool			IsGrowable() const { return fMaxCapacity > fCapacity; }
+
+	public:
+
+		// Returns false if there is no space (and the stack cannot grow)
+		bool Push( const value_type & new_elem )
+		{
+			return fStackPtr < fCapacity ? fData[ fStackPtr ++ ] = new_elem, true : GrowAndPush( value_type( new_elem ) );		// new_elem can be in the stack, so copy it before the stack moves
+		}
+
+		bool Push( value_type && new_elem )
+		{
+			return fStackPtr < fCapacity ? fData[ fStackPtr ++ ] = new_elem, true : GrowAndPush( value_type( new_elem ) );
+		}
+
+	private:
+
+		bool GrowAndPush( value_type new_elem )
+		{
+			return Grow() ? fData[ fStackPtr ++ ] = new_elem, true : false;
+		}
+
+	public:
+
+		bool Pop( value_type & ret_elem )
+		{
+			return Has( 1 ) ? ret_elem = std::move( fData[ -- fStackPtr ] ), true : false;
+		}
+
+		bool Peek( value_type & ret_elem ) const
+		{
+			return Has( 1 ) ? ret_elem = fData[ fStackPtr - 1 ], true : false;
+		}
+
+	public:
+
+		// Returns false if any guard cell was overwritten
+		[[nodiscard]] bool CheckGuards( void ) const
+		{
+			const auto is_guard = [] ( const auto & v ) { return v == kGuardVal; };
+			return std::all_of( fData - kGuardCells, fData, is_guard ) && std::all_of( fData + fCapacity, fData + fCapacity + kGuardCells, is_guard );
+		}
+
+		void RestoreGuards( void )
+		{
+			std::fill( fData - kGuardCells, fData, kGuardVal );
+			std::fill( fData + fCapacity, fData + fCapacity + kGuardCells, kGuardVal );
+		}
+
+	};
+
+
+
+
+	// ---------------------------------------------------------------------------------------------
+	// These are time critical operations therefore they are defined as close the stack as possible.
+	// These are implemented in the series of the following mixin classes.
+	// All others can be implemented with the general interface using exlusively Push and Pop.
+
+
+
+
+
+	template < typename Base >
+	class MSystemWordsStackFor : public Base
+	{
+	public:
+
+		using BaseClass = Base;
+
+		using BaseClass::Push;
+		using BaseClass::Pop;
+		using BaseClass::Peek;
+		using BaseClass::Has;
+
+	public:
+
+		using T = typename BaseClass::value_type;
+		using typename BaseClass::size_type;
+
+		using BaseClass::BaseClass;
+
+	protected:
+
+		using BaseClass::fData;							// kind of a concept, i.e. the base class must have this 
+		using BaseClass::fStackPtr;
+
+	public:
+
+
+		// Forth specific words - defined here for performance
+		constexpr bool Drop()
+		{
+			return Has( 1 ) ? -- fStackPtr, true : false;		
+		}
+
+		constexpr bool Dup()
+		{
+			return Has( 1 ) ? Push( fData[ fStackPtr - 1 ] ) : false;
+		}
+
+		constexpr bool Over()
+		{
+			return Has( 2 ) ? Push( fData[ fStackPtr - 2 ] ) : false;
+		}
+
+		constexpr bool Swap()
+		{
+			if( Has( 2 ) )
+			{
+				auto top { fData[ fStackPtr - 1 ] };
+				fData[ fStackPtr - 1 ] = fData[ fStackPtr - 2 ];
+				fData[ fStackPtr - 2 ] = top;
+				return true;
+			}
+			return false;
+		}
+
+		constexpr bool Rot()
+		{
+			if( Has( 3 ) )
+			{
+				auto top { fData[ fStackPtr - 3 ] };
+				fData[ fStackPtr - 3 ] = fData[ fStackPtr - 2 ];
+				fData[ fStackPtr - 2 ] = fData[ fStackPtr - 1 ];
+				fData[ fStackPtr - 1 ] = top;
+				return true;
+			}
+			return false;
+		}
+
+		constexpr bool Cells()		{ return Has( 1 ) ? fData[ fStackPtr - 1 ] *= sizeof( T ), true : false; }
+
+		constexpr bool CellPlus()	{ return Has( 1 ) ? fData[ fStackPtr - 1 ] += sizeof( T ), true : false; }
+
+
+
+		// @
+		template < typename Type2Read >
+		constexpr bool ReadAt()
+		{
+			return Has( 1 ) ? fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( * reinterpret_cast< Type2Read * >( fData[ fStackPtr - 1 ] ) ), true : false;
+		}
+
+		// !
+		template < typename Type2Write >
+		constexpr bool WriteAt()
+		{
+			return Has( 2 ) ? * reinterpret_cast< Type2Write * >( fData[ fStackPtr - 1 ] ) = BlindValueReInterpretation< Type2Write >( fData[ fStackPtr - 2 ] ), fStackPtr -= 2, true : false;
+		}
+
+		// C+!
+		template < typename Type2Write >
+		constexpr bool UpdateAt()
+		{
+			return Has( 2 ) ? * reinterpret_cast< Type2Write * >( fData[ fStackPtr - 1 ] ) += BlindValueReInterpretation< Type2Write >( fData[ fStackPtr - 2 ] ), fStackPtr -= 2, true : false;
+		}
+
+
+
+		// 2@
+		// ( addr -- x1 x2 )
+		template < typename Type2Read >
+		constexpr bool DoubleReadAt()
+		{
+			if( ! Has( 1 ) )
+				return false;
+			auto addr = reinterpret_cast< Type2Read * >( fData[ fStackPtr - 1 ] );
+			fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( * addr ++ );	// replace addre with [addr]
+			return Push( BlindValueReInterpretation< T >( * addr ) );					// the higher must be pushed
+		}
+
+		// 2!
+		// ( x1 x2 addr -- )
+		template < typename Type2Write >
+		constexpr bool DoubleWriteAt()
+		{
+			if( ! Has( 3 ) )
+				return false;
+			auto addr = reinterpret_cast< Type2Write * >( fData[ fStackPtr - 1 ] );
+			* addr ++	= BlindValueReInterpretation< Type2Write >( fData[ fStackPtr - 3 ] );
+			* addr		= BlindValueReInterpretation< Type2Write >( fData[ fStackPtr - 2 ] );	// higher word to higher address
+			fStackPtr -= 3;
+			return true;
+		}
+
+
+
+	};
+
+
+
+
+
+
+
+
+	template < typename Base >
+	class MLogicalOpsStackFor : public Base
+	{
+	public:
+
+		using BaseClass = Base;
+
+		using BaseClass::BaseClass;
+
+		using BaseClass::Push;
+		using BaseClass::Pop;
+		using BaseClass::Peek;
+		using BaseClass::Has;
+
+	protected:
+
+		using BaseClass::fData;							// kind of a concept, i.e. the base class must have this 
+		using BaseClass::fStackPtr;
+
+
+	public:
+
+		constexpr bool And()	{ return Has( 2 ) ? fData[ fStackPtr - 2 ] &= fData[ fStackPtr - 1 ], -- fStackPtr, true : false; }
+		constexpr bool Or()		{ return Has( 2 ) ? fData[ fStackPtr - 2 ] |= fData[ fStackPtr - 1 ], -- fStackPtr, true : false; }
+		constexpr bool Xor()	{ return Has( 2 ) ? fData[ fStackPtr - 2 ] ^= fData[ fStackPtr - 1 ], -- fStackPtr, true : false; }
+		constexpr bool Neg()	{ return Has( 1 ) ? fData[ fStackPtr - 1 ] = ~ fData[ fStackPtr - 1 ], true : false; }
+
+	};
+
+
+
+
+
+
+
+
+
+
+
+	// ---------------------------------------------------------------------------------------------
+	// The double-cell numbers, made of two cells. The arithmetic goes with the compiler's __int128 if there is one;
+	// otherwise (e.g. on the 32-bit ESP32) it is done on the cell halves.
+
+	struct DoubleCell
+	{
+		CellType	fLo {};
+		CellType	fHi {};
+	};
+
+	constexpr auto kCellBits { 8 * sizeof( CellType ) };
+
+	[[nodiscard]] constexpr bool IsNegative( DoubleCell d ) { return ( d.fHi >> ( kCellBits - 1 ) ) != 0; }
+
+	[[nodiscard]] constexpr DoubleCell DoubleAdd( DoubleCell a, DoubleCell b )
+	{
+		const CellType lo { a.fLo + b.fLo };
+		return { lo, a.fHi + b.fHi + ( lo < a.fLo ? 1 : 0 ) };
+	}
+
+	[[nodiscard]] constexpr DoubleCell DoubleNegate( DoubleCell d )
+	{
+		return DoubleAdd( { ~ d.fLo, ~ d.fHi }, { 1, 0 } );
+	}
+
+	// The full product of two unsigned cells
+	[[nodiscard]] constexpr DoubleCell DoubleUMul( CellType a, CellType b )
+	{
+#ifdef __SIZEOF_INT128__
+		const auto p { static_cast< unsigned __int128 >( a ) * b };
+		return { static_cast< CellType >( p ), static_cast< CellType >( p >> kCellBits ) };
+#else
+		constexpr auto kHalf { kCellBits / 2 };
+		constexpr CellType kMask { ( CellType( 1 ) << kHalf ) - 1 };
+
+		const CellType a_lo { a & kMask }, a_hi { a >> kHalf }, b_lo { b & kMask }, b_hi { b >> kHalf };
+
+		const CellType ll { a_lo * b_lo }, lh { a_lo * b_hi }, hl { a_hi * b_lo }, hh { a_hi * b_hi };
+		const CellType mid { ( ll >> kHalf ) + ( lh & kMask ) + ( hl & kMask ) };
+
+		return { ( mid << kHalf ) | ( ll & kMask ), hh + ( lh >> kHalf ) + ( hl >> kHalf ) + ( mid >> kHalf ) };
+#endif
+	}
+
+	// The quotient and the remainder of n / d - the caller checks if n.fHi < d (otherwise the quotient does not fit into a cell) 
+	constexpr void DoubleUDivMod( DoubleCell n, CellType d, CellType & quot, CellType & rem )
+	{
+		assert( d != 0 && n.fHi < d );
+#ifdef __SIZEOF_INT128__
+		const auto nn { static_cast< unsigned __int128 >( n.fHi ) << kCellBits | n.fLo };
+		quot = static_cast< CellType >( nn / d );
+		rem = static_cast< CellType >( nn % d );
+#else
+		// The long division, bit by bit
+		rem = n.fHi, quot = 0;
+		for( auto i { kCellBits }; i > 0; -- i )
+		{
+			const bool carry { ( rem >> ( kCellBits - 1 ) ) != 0 };
+			rem = rem << 1 | n.fLo >> ( kCellBits - 1 );
+			n.fLo <<= 1;
+			quot <<= 1;
+			if( carry || rem >= d )
+				rem -= d, quot |= 1;
+		}
+#endif
+	}
+
+	// The symmetric division (the quotient rounded toward zero) of the signed numbers. 
+	// Returns false if the quotient does not fit into a cell. 
+	[[nodiscard]] constexpr bool DoubleSDivRem( DoubleCell n, SignedIntType d, SignedIntType & quot, SignedIntType & rem )
+	{
+		const bool n_neg { IsNegative( n ) }, d_neg { d < 0 };
+		const auto n_abs { n_neg ? DoubleNegate( n ) : n };
+		const auto d_abs { d_neg ? CellType( 0 ) - static_cast< CellType >( d ) : static_cast< CellType >( d ) };
+
+		if( n_abs.fHi >= d_abs )
+			return false;
+
+		CellType q {}, r {};
+		DoubleUDivMod( n_abs, d_abs, q, r );
+
+		constexpr CellType kMinAbs { CellType( 1 ) << ( kCellBits - 1 ) };		// the magnitude of the most negative value
+		if( n_neg != d_neg ? q > kMinAbs : q >= kMinAbs )
+			return false;
+
+		quot = static_cast< SignedIntType >( n_neg != d_neg ? CellType( 0 ) - q : q );
+		rem = static_cast< SignedIntType >( n_neg ? CellType( 0 ) - r : r );
+		return true;
+	}
+
+	// The full product of two signed cells
+	[[nodiscard]] constexpr DoubleCell DoubleSMul( SignedIntType a, SignedIntType b )
+	{
+		const auto abs_val = [] ( SignedIntType x ) { return x < 0 ? CellType( 0 ) - static_cast< CellType >( x ) : static_cast< CellType >( x ); };
+		const auto p { DoubleUMul( abs_val( a ), abs_val( b ) ) };
+		return ( a < 0 ) != ( b < 0 ) ? DoubleNegate( p ) : p;
+	}
+
+
+
+	template < typename Base >
+	class MArithmeticOpsStackFor : public Base
+	{
+
+	public:
+
+		using BaseClass = Base;
+
+		using BaseClass::Push;
+		using BaseClass::Pop;
+		using BaseClass::Peek;
+		using BaseClass::Has;
+
+	public:
+
+		using T = typename BaseClass::value_type;
+		using typename BaseClass::size_type;
+
+		using BaseClass::BaseClass;
+
+	protected:
+
+		using BaseClass::fData;							// kind of a concept, i.e. the base class must have this 
+		using BaseClass::fStackPtr;
+
+
+	public:
+
+
+		template < typename A >
+		constexpr bool Plus()
+		{
+			if( Has( 2 ) )
+			{
+				auto top { BlindValueReInterpretation< A >( fData[ -- fStackPtr ] ) };
+				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) + top );
+				return true;
+			}
+
+			return false;
+		}
+
+		template < typename A >
+		constexpr bool Minus()
+		{
+			if( Has( 2 ) )
+			{
+				auto top { BlindValueReInterpretation< A >( fData[ -- fStackPtr ] ) };
+				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) - top );
+				return true;
+			}
+
+			return false;
+		}
+
+		template < typename A >
+		constexpr bool Mult()
+		{
+			if( Has( 2 ) )
+			{
+				auto top { BlindValueReInterpretation< A >( fData[ -- fStackPtr ] ) };
+				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) * top );
+				return true;
+			}
+
+			return false;
+		}
+
+		template < typename A >
+		constexpr bool Div()
+		{
+			if( Has( 2 ) )
+			{
+				auto top { BlindValueReInterpretation< A >( fData[ -- fStackPtr ] ) };
+				if( top == A( 0 ) )
+					throw ForthError( "div by 0" );
+				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) / top );
+				return true;
+			}
+
+			return false;
+		}
+
+		template < typename A >
+		constexpr bool Mod()
+		{
+			if( Has( 2 ) )
+			{
+				auto top { BlindValueReInterpretation< A >( fData[ -- fStackPtr ] ) };
+				if( top == A( 0 ) )
+					throw ForthError( "div by 0" );
+				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) % top );
+				return true;
+			}
+
+			return false;
+		}
+
+	private:
+
+		// The double number which low cell is pos cells from the top (the high cell is above it)
+		[[nodiscard]] constexpr DoubleCell GetDouble( size_type pos ) const
+		{
+			return { BlindValueReInterpretation< CellType >( fData[ fStackPtr - pos ] ), BlindValueReInterpretation< CellType >( fData[ fStackPtr - pos + 1 ] ) };
+		}
+
+		constexpr void SetDouble( size_type pos, DoubleCell d )
+		{
+			fData[ fStackPtr - pos ] = BlindValueReInterpretation< T >( d.fLo );
+			fData[ fStackPtr - pos + 1 ] = BlindValueReInterpretation< T >( d.fHi );
+		}
+
+		template < typename A >
+		[[nodiscard]] constexpr A CellAt( size_type pos ) const { return BlindValueReInterpretation< A >( fData[ fStackPtr - pos ] ); }
+
+	public:
+
+		// Double-cell arithmetic - a double number takes two cells ( lo hi ), the high cell on top
+
+		// D+ ( d1 d2 -- d1+d2 )
+		constexpr bool DPlus()
+		{
+			return Has( 4 ) ? SetDouble( 4, DoubleAdd( GetDouble( 4 ), GetDouble( 2 ) ) ), fStackPtr -= 2, true : false;
+		}
+
+		// D- ( d1 d2 -- d1-d2 )
+		constexpr bool DMinus()
+		{
+			return Has( 4 ) ? SetDouble( 4, DoubleAdd( GetDouble( 4 ), DoubleNegate( GetDouble( 2 ) ) ) ), fStackPtr -= 2, true : false;
+		}
+
+		// DNEGATE ( d -- -d )
+		constexpr bool DNegate()
+		{
+			return Has( 2 ) ? SetDouble( 2, DoubleNegate( GetDouble( 2 ) ) ), true : false;
+		}
+
+		// S>D ( n -- d )
+		constexpr bool SToD()
+		{
+			return Has( 1 ) ? Push( BlindValueReInterpretation< T >( CellAt< SignedIntType >( 1 ) < 0 ? ~ CellType( 0 ) : CellType( 0 ) ) ) : false;
+		}
+
+		// UM* ( u1 u2 -- ud )
+		constexpr bool UMStar()
+		{
+			return Has( 2 ) ? SetDouble( 2, DoubleUMul( CellAt< CellType >( 2 ), CellAt< CellType >( 1 ) ) ), true : false;
+		}
+
+		// M* ( n1 n2 -- d )
+		constexpr bool MStar()
+		{
+			return Has( 2 ) ? SetDouble( 2, DoubleSMul( CellAt< SignedIntType >( 2 ), CellAt< SignedIntType >( 1 ) ) ), true : false;
+		}
+
+		// UM/MOD ( ud u -- u_rem u_quot )
+		constexpr bool UMSlashMod()
+		{
+			if( ! Has( 3 ) )
+				return false;
+
+			const auto d { CellAt< CellType >( 1 ) };
+			if( d == 0 )
+				throw ForthError( "div by 0" );
+
+			const auto n { GetDouble( 3 ) };
+			if( n.fHi >= d )
+				throw ForthError( "division overflow" );
+
+			CellType quot {}, rem {};
+			DoubleUDivMod( n, d, quot, rem );
+			-- fStackPtr;
+			SetDouble( 2, { rem, quot } );
+			return true;
+		}
+
+		// SM/REM ( d n -- n_rem n_quot ) - the symmetric division
+		constexpr bool SMSlashRem()
+		{
+			if( ! Has( 3 ) )
+				return false;
+
+			const auto d { CellAt< SignedIntType >( 1 ) };
+			if( d == 0 )
+				throw ForthError( "div by 0" );
+
+			SignedIntType quot {}, rem {};
+			if( ! DoubleSDivRem( GetDouble( 3 ), d, quot, rem ) )
+				throw ForthError( "division overflow" );
+
+			-- fStackPtr;
+			SetDouble( 2, { static_cast< CellType >( rem ), static_cast< CellType >( quot ) } );
+			return true;
+		}
+
+		// */MOD ( n1 n2 n3 -- n_rem n_quot ) - with the double-cell intermediate product n1*n2
+		// */ ( n1 n2 n3 -- n_quot )
+		template < bool KeepRem >
+		constexpr bool StarSlashMod()
+		{
+			if( ! Has( 3 ) )
+				return false;
+
+			const auto d { CellAt< SignedIntType >( 1 ) };
+			if( d == 0 )
+				throw ForthError( "div by 0" );
+
+			SignedIntType quot {}, rem {};
+			if( ! DoubleSDivRem( DoubleSMul( CellAt< SignedIntType >( 3 ), CellAt< SignedIntType >( 2 ) ), d, quot, rem ) )
+				throw ForthError( "division overflow" );
+
+			if constexpr( KeepRem )
+			{
+				-- fStackPtr;
+				SetDouble( 2, { static_cast< CellType >( rem ), static_cast< CellType >( quot ) } );
+			}
+			else
+			{
+				fStackPtr -= 2;
+				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( quot );
+			}
+			return true;
+		}
+
+	public:
+
+
+		// Be careful - the returned value indicates a success of an operation, which is true if there is enough data on the stack
+		// However, the comparison result goes to the topmost cell of the stack !! (i.e. this is NOT what is returned!)
+
+		template < typename A >
+		constexpr bool EQ()
+		{
+			if( Has( 2 ) )
+			{
+				auto top { BlindValueReInterpretation< A >( fData[ -- fStackPtr ] ) };
+				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) == top ? kBoolTrue : kBoolFalse;
+				return true;
+			}
+
+			return false;
+		}
+
+		template < typename A >
+		constexpr bool NE() 
+		{
+			if( Has( 2 ) )
+			{
+				auto top { BlindValueReInterpretation< A >( fData[ -- fStackPtr ] ) };
+				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) != top ? kBoolTrue : kBoolFalse;
+				return true;
+			}
+
+			return false;
+		}
+
+		template < typename A >
+		constexpr bool LT() 
+		{
+			if( Has( 2 ) )
+			{
+				auto top { BlindValueReInterpretation< A >( fData[ -- fStackPtr ] ) };
+				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) < top ? kBoolTrue : kBoolFalse;
+				return true;
+			}
+
+			return false;
+		}
+
+		template < typename A >
+		constexpr bool LE()
+		{
+			if( Has( 2 ) )
+			{
+				auto top { BlindValueReInterpretation< A >( fData[ -- fStackPtr ] ) };
+				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) <= top ? kBoolTrue : kBoolFalse;
+				return true;
+			}
+
+			return false;
+		}
+
+		template < typename A >
+		constexpr bool GT()
+		{
+			if( Has( 2 ) )
+			{
+				auto top { BlindValueReInterpretation< A >( fData[ -- fStackPtr ] ) };
+				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) > top ? kBoolTrue : kBoolFalse;
+				return true;
+			}
+
+			return false;
+		}
+
+		template < typename A >
+		constexpr bool GE()
+		{
+			if( Has( 2 ) )
+			{
+				auto top { BlindValueReInterpretation< A >( fData[ -- fStackPtr ] ) };
+				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) >= top ? kBoolTrue : kBoolFalse;
+				return true;
+			}
+
+			return false;
+		}
+
+
+
+
+		// Spec for 0
+
+		template < typename A >
+		constexpr bool EQ_0()
+		{
+			if( Has( 1 ) )
+			{
+				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) == static_cast< A >( 0 ) ? kBoolTrue : kBoolFalse;
+				return true;
+			}
+
+			return false;
+		}
+
+		template < typename A >
+		constexpr bool NE_0()
+		{
+			if( Has( 1 ) )
+			{
+				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) != static_cast< A >( 0 ) ? kBoolTrue : kBoolFalse;
+				return true;
+			}
+
+			return false;
+		}
+
+		template < typename A >
+		constexpr bool GT_0()
+		{
+			if( Has( 1 ) )
+			{
+				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) > static_cast< A >( 0 ) ? kBoolTrue : kBoolFalse;
+				return true;
+			}
+
+			return false;
+		}
+
+		template < typename A >
+		constexpr bool GE_0()
+		{
+			if( Has( 1 ) )
+			{
+				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) >= static_cast< A >( 0 ) ? kBoolTrue : kBoolFalse;
+				return true;
+			}
+
+			return false;
+		}
+
+		template < typename A >
+		constexpr bool LT_0()
+		{
+			if( Has( 1 ) )
+			{
+				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) < static_cast< A >( 0 ) ? kBoolTrue : kBoolFalse;
+				return true;
+			}
+
+			return false;
+		}
+
+		template < typename A >
+		constexpr bool LE_0()
+		{
+			if( Has( 1 ) )
+			{
+				fData[ fStackPtr - 1 ] = BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) <= static_cast< A >( 0 ) ? kBoolTrue : kBoolFalse;
+				return true;
+			}
+
+			return false;
+		}
+
+
+
+	public:
+
+		// Forth extras - here for speed-up
+
+		template < typename A >
+		constexpr bool OnePlus()
+		{
+			return  Has( 1 ) ? fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) + static_cast< A >( 1 ) ), true : false;
+		}
+
+		template < typename A >
+		constexpr bool OneMinus()
+		{
+			return  Has( 1 ) ? fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) - static_cast< A >( 1 ) ), true : false;
+		}
+
+		template < typename A >
+		constexpr bool TwoPlus()
+		{
+			return  Has( 1 ) ? fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) + static_cast< A >( 2 ) ), true : false;
+		}
+
+		template < typename A >
+		constexpr bool TwoMinus()
+		{
+			return  Has( 1 ) ? fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) - static_cast< A >( 2 ) ), true : false;
+		}
+
+		template < typename A >
+		constexpr bool TwoTimes()
+		{
+			return  Has( 1 ) ? fData[ fStackPtr - 1 ] = BlindValueReInterpretation< T >( BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) + BlindValueReInterpretation< A >( fData[ fStackPtr - 1 ] ) ), true : false;
+		}
+
+
+	};
+
+
+
+
+
+
+
+
+	// Assembly them all together 
+	template < typename T, auto MaxElems >
+	using ForthStackFor = MSystemWordsStackFor< MLogicalOpsStackFor< MArithmeticOpsStackFor< TStackFor< T, MaxElems > > > >;
+
+	// The same with the size set at run-time, and the checks as set by the policy
+	template < typename T, EStackCheck StackCheck = EStackCheck::kChecked >
+	using ForthDynStackFor = MSystemWordsStackFor< MLogicalOpsStackFor< MArithmeticOpsStackFor< TDynStackFor< T, StackCheck > > > >;
+
+
+
+
+
+
+}		// End of the BCForth namespace
+
+
+
+
+
+
+// ----------------------------------------------------
+
+
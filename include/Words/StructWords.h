@@ -1,551 +1,623 @@
-// ========================================================================
-//
-// The Forth interpreter-compiler by Prof. Boguslaw Cyganek (C) 2021
-//
-// The software is supplied as is and for educational purposes
-// without any guarantees nor responsibility of its use in any application. 
-//
-// ========================================================================
-
-
-#pragma once
-
-
-
-#include "Words.h"
-#include <iostream>
-
-
-namespace BCForth
-{
-
-
-
-
-	// Special intermediate node for all structural nodes, such as IF and DO
-	template < typename Base >
-	class StructuralWord : public TWord< Base >
-	{
-
-	public:
-
-		StructuralWord( Base & f ) : TWord< Base >( f ) {}
-		
-		StructuralWord( StructuralWord && ) = default;
-		StructuralWord & operator = ( StructuralWord && ) = default;
-
-	public:
-
-		void operator () ( void ) override = 0;
-
-	};
-
-
-
-
-	// Just a composite DP, i.e. a word consisting of other words
-	template < typename Base >
-	class CompoWord : public StructuralWord< Base >
-	{
-	public:
-
-		using WordPtr	= typename Base::WordPtr;
-		using WordsVec	= std::vector< WordPtr >;
-
-		using StructuralWord< Base >::GetForth;
-
-	private:
-
-		WordsVec		fWordsVec;
-
-	public:
-
-		CompoWord( Base & f ) : StructuralWord< Base >( f )
-		{ fWordsVec.reserve( kCompoWord_VecInitReserveSize ); }
-
-		CompoWord( CompoWord && cw )
-			:  StructuralWord< Base >( cw.GetForth() ),
-				fWordsVec( std::move( cw.fWordsVec ) ), fWordsDebugInfoVec( std::move( cw.fWordsDebugInfoVec ) )
-		{
-			//fWordsVec = std::move( cw.fWordsVec );
-			//fWordsDebugInfoVec = std::move( cw.fWordsDebugInfoVec );		
-		}
-
-		CompoWord & operator = ( CompoWord && cw )
-		{
-			fWordsVec = std::move( cw.fWordsVec );
-			fWordsDebugInfoVec = std::move( cw.fWordsDebugInfoVec );
-			return * this;
-		}
-
-
-	private:
-
-		using WordsDebugInfoVec	= std::vector< DebugFileInfo >;
-
-		WordsDebugInfoVec		fWordsDebugInfoVec;
-
-
-	public:
-
-		const WordsDebugInfoVec	& GetWordsDebugInfoVec() { return fWordsDebugInfoVec; }
-
-
-		void AddWord( WordPtr wp, DebugFileInfo dfi = DebugFileInfo() ) 
-		{ 
-			assert( wp ); 
-			fWordsVec.push_back( wp ); 
-			fWordsDebugInfoVec.emplace_back( dfi );
-		}
-
-
-		[[nodiscard]] WordsVec &				GetWordsVec( void )			{ return fWordsVec; }
-		[[nodiscard]] const WordsVec &		GetWordsVec( void ) const	{ return fWordsVec; }
-
-	public:
-
-		// Execute all
-		void operator () ( void ) override;
-
-	};
-
-
-
-	// A helper for the CompoWords
-	constexpr bool IsEmpty( const auto & compo_word )
-	{
-		return compo_word.GetWordsVec().size() == 0;
-	}
-
-
-
-
-	// ------------------------
-	// Structural patterns
-
-
-
-
-	template < typename Base >
-	class IF : public StructuralWord< Base >
-	{
-		using DataStack = typename Base::DataStack;
-		using StructuralWord< Base >::GetDataStack;
-
-		using CW = CompoWord< Base >;
-
-		CW	fTrueBranch;
-		CW	fFalseBranch;
-
-	public:
-
-		[[nodiscard]] CW &	GetTrueNode( void )		{ return fTrueBranch; }
-		[[nodiscard]] CW &	GetFalseNode( void )	{ return fFalseBranch; }
-
-	public:
-
-		IF( Base & f ) : StructuralWord< Base >( f ), fTrueBranch( f ), fFalseBranch( f ) {}
-
-	public:
-
-		void operator () ( void ) override
-		{
-			if( typename DataStack::value_type t {}; GetDataStack().Pop( t ) )
-				t == kBoolFalse ? fFalseBranch() : fTrueBranch();
-			else
-				throw ForthError( "unexpectedly empty stack" );
-		}
-
-	};
-
-
-
-
-
-
-
-	// LEAVE makes an immediate exit from the current loop
-	// Achieved by throwing a special exception
-	template < typename Base >
-	class LEAVE : public StructuralWord< Base >
-	{
-		using BaseClass = StructuralWord< Base >;
-
-	public:
-
-		class LEAVE_Exception : std::exception	// we need only its type, no action
-		{};
-
-	public:
-
-		LEAVE( Base & f ) : BaseClass( f ) {}
-
-	public:
-
-		void operator () ( void ) override
-		{
-			throw LEAVE_Exception();		// to immediatelly exit from a loop we throw - this will be caught by the loop functor
-		}
-
-	};
-
-
-
-	// <limit> <initial> DO <words to repeat>          LOOP
-	// <limit> <initial> DO <words to repeat> <value> +LOOP
-	// Expects the initial loop index on top of the stack, with the limit value beneath it
-	template < typename Base >
-	class DO_LOOP : public StructuralWord< Base >
-	{
-		using DataStack = typename Base::DataStack;
-		using TWord< Base >::GetDataStack;
-
-		using CW = CompoWord< Base >;
-
-		CW	fBodyNodes;
-
-		SignedIntType		fIndex {};
-
-	public:
-
-		[[nodiscard]] CW &			GetBodyNodes( void ) { return fBodyNodes; }
-
-		[[nodiscard]] SignedIntType	GetIndex( void ) const { return fIndex; }
-
-	public:
-
-		DO_LOOP( Base & f ) : StructuralWord< Base >( f ), fBodyNodes( f ) {}
-
-	public:
-
-		void operator () ( void ) override
-		{
-			// Get the current limits from teh stack
-			auto & ds { GetDataStack() };
-			if( typename DataStack::value_type limit {}, initial {}; ds.Pop( initial ) && ds.Pop( limit ) )
-			{
-
-				fIndex						= static_cast< SignedIntType >( initial );
-				const SignedIntType kTo	= static_cast< SignedIntType >( limit );
-
-				SignedIntType step_val {};
-
-				try
-				{
-					do
-					{
-						fBodyNodes();		// the last one should leave the increment step on the data stack
-
-						if( typename DataStack::value_type	s {}; ds.Pop( s ) )
-							step_val = static_cast< SignedIntType >( s );
-						else
-							throw ForthError( "unexpectedly empty stack when processing DO" );
-
-						assert( step_val != 0 );		// otherwise the loop is infinite
-						fIndex += step_val;
-
-					} while( step_val < 0 ? fIndex >= kTo : fIndex < kTo );
-				}
-				catch( typename LEAVE< Base >::LEAVE_Exception & )
-				{
-					// this one is special for LEAVE - everything is under control, just return
-					return;
-				}
-				// all other potential exceptions go to upper layers
-
-			}
-			else
-			{
-				throw ForthError( "unexpectedly empty stack when processing DO" );
-			}
-		}
-
-	};
-
-
-	// ?DO loop
-	template < typename Base >
-	class QDO_LOOP : public DO_LOOP< Base >
-	{
-		protected:
-		using DataStack = typename Base::DataStack;
-
-	public:
-
-		QDO_LOOP( Base & f ) : DO_LOOP< Base >( f ) {}
-
-	public:
-
-		void operator () ( void ) override
-		{
-			auto & ds = this->GetForth().GetDataStack();
-			if( const auto ds_size = ds.size(); ds_size < 2 )
-				throw ForthError( "unexpectedly empty stack when processing ?DO" );
-			else if( const auto ds_data = ds.data(); ds_data[ ds_size - 1 ] != ds_data[ ds_size - 2 ] )
-				DO_LOOP< Base >::operator() ();		// call the base
-		}
-	};
-
-
-
-
-
-	// Loop index node 
-	template < typename Base >
-	class I_LOOP : public TWord< Base >
-	{
-		using TWord< Base >::GetDataStack;
-
-		const DO_LOOP< Base > &	fMyLoopNode;
-
-	public:
-
-		I_LOOP( Base & f, const DO_LOOP< Base > & my_loop ) : TWord< Base >( f ), fMyLoopNode( my_loop ) {}
-
-	public:
-
-		void operator () ( void ) override
-		{
-			GetDataStack().Push( static_cast< CellType >( fMyLoopNode.GetIndex() ) );
-		}
-
-	};
-
-
-
-
-
-
-
-	// There are 3 structures starting with BEGIN
-	// 
-	// BEGIN ... S ... AGAIN		( indefinite )
-	// BEGIN ... S ..v UNTIL		( iterate as long as v is FALSE )
-	// BEGIN ... SA ...v WHILE ... SB ... REPEAT ( WHILE checks v, if FALSE, then exit the loop; otherwise REPEAT jumps to BEGIN )
-	//
-	// The thing is, however, that just when processing BEGIN we don't know exactly which version it is.
-	// This is set only after reaching one of the keywords: AGAIN or UNTIL or WHILE-REPEAT
-	//
-	template < typename Base >
-	class BEGIN_LOOP : public StructuralWord< Base >
-	{
-		using DataStack = typename Base::DataStack;
-		using TWord< Base >::GetDataStack;
-
-		using CW = CompoWord< Base >;
-
-		CW	fBegin_Nodes;		// all nodes in the BEGIN	 ... WHILE (UNTIL) branch
-		CW	fWhile_Nodes;		// all nodes in the              WHILE ... REPEAT branch (empty for the AGAIN and UNTIL versions)
-
-
-	private:
-
-		// Set to exit the loop asap
-		bool Exit( void )
-		{
-			return false;
-		}
-
-		// Returns true to continue the loop - this one always
-		bool Again( void )
-		{
-			return true;
-		}
-
-		// Returns true to continue the loop - this one if condition on the stack is FALSE
-		bool Until( void )
-		{
-			if( typename DataStack::value_type	cond {}; GetDataStack().Pop( cond ) )
-				return cond ? false : true;
-			else
-				throw ForthError( "unexpectedly empty stack" );	
-		}
-
-		// Returns true to continue the loop - this one if condition on the stack is TRUE
-		bool WhileRepeat( void )
-		{
-			if( typename DataStack::value_type	cond {}; GetDataStack().Pop( cond ) )
-				return cond ? fWhile_Nodes(), true : false;
-			else
-				throw ForthError( "unexpectedly empty stack" );	
-		}
-
-
-
-		std::function< bool ( void ) >		fInternalFun;
-
-
-	public:
-
-		[[nodiscard]] CW &	Get_Begin_Nodes( void ) { return fBegin_Nodes; }
-		[[nodiscard]] CW &	Get_While_Nodes( void ) { return fWhile_Nodes; }
-
-
-		enum class EBeginLoopType { kAgain, kUntil, kWhileRepeat, kExit };
-
-		void SetLoopType( EBeginLoopType ltp ) 
-		{
-			switch( ltp )
-			{
-			case EBeginLoopType::kAgain:
-				fInternalFun = [ this ] () { return Again(); } ;
-				break;
-
-			case EBeginLoopType::kUntil:
-				fInternalFun = [ this ] () { return Until(); } ;
-				break;
-
-			case EBeginLoopType::kWhileRepeat:
-				fInternalFun = [ this ] () { return WhileRepeat(); } ;
-				break;
-
-			case EBeginLoopType::kExit:
-				fInternalFun = [ this ] () { return Exit(); } ;
-				break;
-			}
-		} 
-
-	public:
-
-		BEGIN_LOOP( Base & f ) : StructuralWord< Base >( f ), fBegin_Nodes( f ), fWhile_Nodes( f )
-		{ 
-			SetLoopType( EBeginLoopType::kAgain ); 
-		}
-
-	public:
-
-		void operator () ( void ) override
-		{
-			try
-			{
-				// ---------------------
-				do
-				{
-					fBegin_Nodes();		
-				}
-				while( fInternalFun() );
-				// ---------------------
-
-			}
-			catch( typename LEAVE< Base >::LEAVE_Exception & )
-			{
-				// this one is special for LEAVE - everything is under control, just return
-				return;
-			}
-			// all other potential exceptions go to upper layers
-
-
-		}
-
-	};
-
-
-
-	// It can be associated with a BEGIN ... loop 
-	// and when executed it makes the loop to break
-	template < typename Base >
-	class EXIT_BEGIN_LOOP : public TWord< Base >
-	{
-		BEGIN_LOOP< Base > &	fMyBeginNode;
-
-	public:
-
-		EXIT_BEGIN_LOOP( Base & f, BEGIN_LOOP< Base > & my_loop ) : TWord< Base >( f ), fMyBeginNode( my_loop ) {}
-
-	public:
-
-		void operator () ( void ) override
-		{
-			fMyBeginNode.SetLoopType( BEGIN_LOOP< Base >::EBeginLoopType::kExit );
-		}
-
-	};
-
-
-
-	// Just a placeholder
-	template < typename Base >
-	class CASE : public CompoWord< Base >
-	{
-		using BaseClass = CompoWord< Base >;
-
-	public:
-
-		using BaseClass::AddWord;
-
-	public:
-
-		CASE( Base & f ) : BaseClass( f ) {}
-
-	public:
-
-		void operator () ( void ) override
-		{
-			BaseClass::operator() ();		// call the base composite
-		}
-
-	};
-
-
-
-
-
-
-	// ------------------------
-	// Creational pattern
-	//
-	//: ARRAY ( n -- ) CREATE DUP , CELLS ALLOT
-	//	DOES> ( n -- a ) SWAP OVER @ OVER < OVER 1 < OR ABORT" Out of range" 
-	//	CELLS + ;
-	//
-	//: MSG ( -- ) CREATE
-	//	DOES> ( -- ) COUNT TYPE ;
-	//
-	// MSG (CR)		2 C, 0D C, 0A C,
-	//
-
-	template < typename Base >
-	class DOES : public StructuralWord< Base >
-	{
-		using DataStack = typename Base::DataStack;
-		using StructuralWord< Base >::GetDataStack;
-
-		using CW = CompoWord< Base >;
-
-		CW	fCreationBranch;
-		CW	fBehaviorBranch;
-
-	public:
-
-		[[nodiscard]] CW &	GetCreationNode( void )		{ return fCreationBranch; }
-		[[nodiscard]] CW &	GetBehaviorNode( void )		{ return fBehaviorBranch; }
-
-	public:
-
-		DOES( Base & f ) : StructuralWord< Base >( f ), fCreationBranch( f ), fBehaviorBranch( f ) {}
-
-	public:
-
-		// 12 ARRAY SHUTTER
-		// ...
-		// 3 SHUTTER
-		//
-		// This needs to add a defining word into the dictionary
-		void operator () ( void ) override
-		{
-			assert( fCreationBranch.GetWordsVec().size() > 0 );
-			fCreationBranch();		// call the creational branch
-		}
-
-	};
-
-
-
-
-
-}	// The end of the BCForth namespace
-
-
-
-
-
+// ========================================================================
+//
+// The Forth interpreter-compiler by Prof. Boguslaw Cyganek (C) 2021
+//
+// The software is supplied as is and for educational purposes
+// without any guarantees nor responsibility of its use in any application. 
+//
+// ========================================================================
+
+
+#pragma once
+
+
+
+#include "Words.h"
+#include <iostream>
+
+
+namespace BCForth
+{
+
+
+
+
+	// Special intermediate node for all structural nodes, such as IF and DO
+	template < typename Base >
+	class StructuralWord : public TWord< Base >
+	{
+
+	public:
+
+		StructuralWord( Base & f ) : TWord< Base >( f ) {}
+		
+		StructuralWord( StructuralWord && ) = default;
+		StructuralWord & operator = ( StructuralWord && ) = default;
+
+	public:
+
+		void operator () ( void ) override = 0;
+
+	};
+
+
+
+
+	// Just a composite DP, i.e. a word consisting of other words
+	// The short bodies, e.g. of most of the IF branches, are held inside the object.
+	// The debug info (if any) is kept aside, to make the object smaller.
+	template < typename Base >
+	class CompoWord : public StructuralWord< Base >
+	{
+	public:
+
+		using WordPtr	= typename Base::WordPtr;
+		using WordsVec	= TSmallVecFor< WordPtr, kCompoWord_InlineSize >;
+
+		using StructuralWord< Base >::GetForth;
+
+	private:
+
+		WordsVec		fWordsVec;
+
+	public:
+
+		CompoWord( Base & f ) : StructuralWord< Base >( f ) {}
+
+		CompoWord( CompoWord && cw )
+			:  StructuralWord< Base >( cw.GetForth() ),
+				fWordsVec( std::move( cw.fWordsVec ) ), fWordsDebugInfoVec( std::move( cw.fWordsDebugInfoVec ) )
+		{
+		}
+
+		CompoWord & operator = ( CompoWord && cw )
+		{
+			fWordsVec = std::move( cw.fWordsVec );
+			fWordsDebugInfoVec = std::move( cw.fWordsDebugInfoVec );
+			return * this;
+		}
+
+
+	private:
+
+		using WordsDebugInfoVec	= std::vector< DebugFileInfo >;
+
+		std::unique_ptr< WordsDebugInfoVec >		fWordsDebugInfoVec;		// allocated with the first word, and only in the debug version
+
+	public:
+
+		// Returns nullptr if there is no debug info
+		const WordsDebugInfoVec * GetWordsDebugInfoVec() const { return fWordsDebugInfoVec.get(); }
+
+
+		void AddWord( WordPtr wp, [[maybe_unused]] DebugFileInfo dfi = DebugFileInfo() ) 
+		{ 
+			assert( wp ); 
+			fWordsVec.push_back( wp ); 
+#if DEBUG_ON
+			if( ! fWordsDebugInfoVec )
+				fWordsDebugInfoVec = std::make_unique< WordsDebugInfoVec >( fWordsVec.size() - 1 );		// the words added with GetWordsVec() have no info
+			fWordsDebugInfoVec->emplace_back( dfi );
+#endif
+		}
+
+
+		[[nodiscard]] WordsVec &				GetWordsVec( void )			{ return fWordsVec; }
+		[[nodiscard]] const WordsVec &		GetWordsVec( void ) const	{ return fWordsVec; }
+
+	public:
+
+		void Finalize( void ) override
+		{
+			fWordsVec.shrink_to_fit();
+			if( fWordsDebugInfoVec )
+				fWordsDebugInfoVec->shrink_to_fit();
+		}
+
+		[[nodiscard]] size_type GetHeapBytes( void ) const override
+		{
+			return fWordsVec.heap_bytes() 
+					+ ( fWordsDebugInfoVec ? sizeof( WordsDebugInfoVec ) + fWordsDebugInfoVec->capacity() * sizeof( DebugFileInfo ) : 0 );
+		}
+
+	public:
+
+		// Execute all
+		void operator () ( void ) override;
+
+	};
+
+
+
+	// A helper for the CompoWords
+	constexpr bool IsEmpty( const auto & compo_word )
+	{
+		return compo_word.GetWordsVec().size() == 0;
+	}
+
+
+
+
+	// ------------------------
+	// Structural patterns
+
+
+
+
+	template < typename Base >
+	class IF : public StructuralWord< Base >
+	{
+		using DataStack = typename Base::DataStack;
+		using StructuralWord< Base >::GetDataStack;
+
+		using CW = CompoWord< Base >;
+
+		CW	fTrueBranch;
+		CW	fFalseBranch;
+
+	public:
+
+		[[nodiscard]] CW &	GetTrueNode( void )		{ return fTrueBranch; }
+		[[nodiscard]] CW &	GetFalseNode( void )	{ return fFalseBranch; }
+
+	public:
+
+		IF( Base & f ) : StructuralWord< Base >( f ), fTrueBranch( f ), fFalseBranch( f ) {}
+
+	public:
+
+		void Finalize( void ) override { fTrueBranch.Finalize(); fFalseBranch.Finalize(); }
+
+		[[nodiscard]] size_type GetHeapBytes( void ) const override { return fTrueBranch.GetHeapBytes() + fFalseBranch.GetHeapBytes(); }
+
+	public:
+
+		void operator () ( void ) override
+		{
+			if( typename DataStack::value_type t {}; GetDataStack().Pop( t ) )
+				t == kBoolFalse ? fFalseBranch() : fTrueBranch();
+			else
+				throw ForthError( "unexpectedly empty stack" );
+		}
+
+	};
+
+
+
+
+
+
+
+	// LEAVE makes an immediate exit from the current loop
+	// Achieved by throwing a special exception
+	template < typename Base >
+	class LEAVE : public StructuralWord< Base >
+	{
+		using BaseClass = StructuralWord< Base >;
+
+	public:
+
+		class LEAVE_Exception : std::exception	// we need only its type, no action
+		{};
+
+	public:
+
+		LEAVE( Base & f ) : BaseClass( f ) {}
+
+	public:
+
+		void operator () ( void ) override
+		{
+			throw LEAVE_Exception();		// to immediatelly exit from a loop we throw - this will be caught by the loop functor
+		}
+
+	};
+
+
+
+	// <limit> <initial> DO <words to repeat>          LOOP
+	// <limit> <initial> DO <words to repeat> <value> +LOOP
+	// Expects the initial loop index on top of the stack, with the limit value beneath it
+	//
+	// The loop control parameters go on the return stack, the limit and then the index on top.
+	// Nothing is kept in the node, so a loop can be re-entered, e.g. by a recursive call.
+	template < typename Base >
+	class DO_LOOP : public StructuralWord< Base >
+	{
+		using DataStack = typename Base::DataStack;
+		using TWord< Base >::GetDataStack;
+
+		using CW = CompoWord< Base >;
+
+		CW	fBodyNodes;
+
+	public:
+
+		[[nodiscard]] CW &			GetBodyNodes( void ) { return fBodyNodes; }
+
+	public:
+
+		DO_LOOP( Base & f ) : StructuralWord< Base >( f ), fBodyNodes( f ) {}
+
+	public:
+
+		void Finalize( void ) override { fBodyNodes.Finalize(); }
+
+		[[nodiscard]] size_type GetHeapBytes( void ) const override { return fBodyNodes.GetHeapBytes(); }
+
+	private:
+
+		// Drops the loop control parameters (and whatever is above them) on any exit from the loop
+		template < typename RS >
+		struct LoopFrameGuard
+		{
+			RS &		fRetStack;
+			size_type	fFrame;
+
+			~LoopFrameGuard() { fRetStack.truncate( fFrame ); }
+		};
+
+	public:
+
+		void operator () ( void ) override
+		{
+			// Get the current limits from teh stack
+			auto & ds { GetDataStack() };
+			if( typename DataStack::value_type limit {}, initial {}; ds.Pop( initial ) && ds.Pop( limit ) )
+			{
+
+				auto & rs { this->GetForth().GetRetStack() };
+				const auto frame { rs.size() };
+				LoopFrameGuard< std::remove_reference_t< decltype( rs ) > >	guard { rs, frame };
+
+				if( ! ( rs.Push( limit ) && rs.Push( initial ) ) )
+					throw ForthError( "return stack overflow when processing DO" );
+
+				const SignedIntType kTo	= static_cast< SignedIntType >( limit );
+
+				SignedIntType index { static_cast< SignedIntType >( initial ) };
+				SignedIntType step_val {};
+
+				try
+				{
+					do
+					{
+						fBodyNodes();		// the last one should leave the increment step on the data stack
+
+						if( typename DataStack::value_type	s {}; ds.Pop( s ) )
+							step_val = static_cast< SignedIntType >( s );
+						else
+							throw ForthError( "unexpectedly empty stack when processing DO" );
+
+						if( rs.size() < frame + 2 )
+							return;			// UNLOOP was called, so this is the last pass
+
+						assert( step_val != 0 );		// otherwise the loop is infinite
+						index = static_cast< SignedIntType >( rs.data()[ frame + 1 ] ) + step_val;		// the stack can move if it grows
+						rs.data()[ frame + 1 ] = static_cast< CellType >( index );
+
+					} while( step_val < 0 ? index >= kTo : index < kTo );
+				}
+				catch( typename LEAVE< Base >::LEAVE_Exception & )
+				{
+					// this one is special for LEAVE - everything is under control, just return
+					return;
+				}
+				// all other potential exceptions go to upper layers
+
+			}
+			else
+			{
+				throw ForthError( "unexpectedly empty stack when processing DO" );
+			}
+		}
+
+	};
+
+
+	// ?DO loop
+	template < typename Base >
+	class QDO_LOOP : public DO_LOOP< Base >
+	{
+		protected:
+		using DataStack = typename Base::DataStack;
+
+	public:
+
+		QDO_LOOP( Base & f ) : DO_LOOP< Base >( f ) {}
+
+	public:
+
+		void operator () ( void ) override
+		{
+			auto & ds = this->GetForth().GetDataStack();
+			if( const auto ds_size = ds.size(); ds_size < 2 )
+				throw ForthError( "unexpectedly empty stack when processing ?DO" );
+			else if( const auto ds_data = ds.data(); ds_data[ ds_size - 1 ] != ds_data[ ds_size - 2 ] )
+				DO_LOOP< Base >::operator() ();		// call the base
+		}
+	};
+
+
+
+
+
+	// Loop index node - reads the loop control parameters straight from the return stack
+	template < typename Base >
+	class I_LOOP : public TWord< Base >
+	{
+		using TWord< Base >::GetDataStack;
+		using TWord< Base >::GetForth;
+
+		const size_type		fDepth;		// counted from the top of the return stack
+
+	public:
+
+		static constexpr size_type kCellsPerLoop { 2 };		// the limit and the index
+
+		// I is the top of the return stack, I' (the limit) is just below, J is the index of the outer loop, and so on
+		I_LOOP( Base & f, size_type depth ) : TWord< Base >( f ), fDepth( depth ) {}
+
+	public:
+
+		void operator () ( void ) override
+		{
+			auto & rs { GetForth().GetRetStack() };
+			if( rs.size() < fDepth )
+				throw ForthError( "loop index used out of a loop" );
+
+			GetDataStack().Push( rs.data()[ rs.size() - fDepth ] );
+		}
+
+	};
+
+
+
+
+
+
+
+	// There are 3 structures starting with BEGIN
+	// 
+	// BEGIN ... S ... AGAIN		( indefinite )
+	// BEGIN ... S ..v UNTIL		( iterate as long as v is FALSE )
+	// BEGIN ... SA ...v WHILE ... SB ... REPEAT ( WHILE checks v, if FALSE, then exit the loop; otherwise REPEAT jumps to BEGIN )
+	//
+	// The thing is, however, that just when processing BEGIN we don't know exactly which version it is.
+	// This is set only after reaching one of the keywords: AGAIN or UNTIL or WHILE-REPEAT
+	//
+	template < typename Base >
+	class BEGIN_LOOP : public StructuralWord< Base >
+	{
+		using DataStack = typename Base::DataStack;
+		using TWord< Base >::GetDataStack;
+
+		using CW = CompoWord< Base >;
+
+		CW	fBegin_Nodes;		// all nodes in the BEGIN	 ... WHILE (UNTIL) branch
+		CW	fWhile_Nodes;		// all nodes in the              WHILE ... REPEAT branch (empty for the AGAIN and UNTIL versions)
+
+
+	private:
+
+		// Set to exit the loop asap
+		bool Exit( void )
+		{
+			return false;
+		}
+
+		// Returns true to continue the loop - this one always
+		bool Again( void )
+		{
+			return true;
+		}
+
+		// Returns true to continue the loop - this one if condition on the stack is FALSE
+		bool Until( void )
+		{
+			if( typename DataStack::value_type	cond {}; GetDataStack().Pop( cond ) )
+				return cond ? false : true;
+			else
+				throw ForthError( "unexpectedly empty stack" );	
+		}
+
+		// Returns true to continue the loop - this one if condition on the stack is TRUE
+		bool WhileRepeat( void )
+		{
+			if( typename DataStack::value_type	cond {}; GetDataStack().Pop( cond ) )
+				return cond ? fWhile_Nodes(), true : false;
+			else
+				throw ForthError( "unexpectedly empty stack" );	
+		}
+
+
+
+		std::function< bool ( void ) >		fInternalFun;
+
+
+	public:
+
+		[[nodiscard]] CW &	Get_Begin_Nodes( void ) { return fBegin_Nodes; }
+		[[nodiscard]] CW &	Get_While_Nodes( void ) { return fWhile_Nodes; }
+
+
+		enum class EBeginLoopType { kAgain, kUntil, kWhileRepeat, kExit };
+
+		void SetLoopType( EBeginLoopType ltp ) 
+		{
+			switch( ltp )
+			{
+			case EBeginLoopType::kAgain:
+				fInternalFun = [ this ] () { return Again(); } ;
+				break;
+
+			case EBeginLoopType::kUntil:
+				fInternalFun = [ this ] () { return Until(); } ;
+				break;
+
+			case EBeginLoopType::kWhileRepeat:
+				fInternalFun = [ this ] () { return WhileRepeat(); } ;
+				break;
+
+			case EBeginLoopType::kExit:
+				fInternalFun = [ this ] () { return Exit(); } ;
+				break;
+			}
+		} 
+
+	public:
+
+		BEGIN_LOOP( Base & f ) : StructuralWord< Base >( f ), fBegin_Nodes( f ), fWhile_Nodes( f )
+		{ 
+			SetLoopType( EBeginLoopType::kAgain ); 
+		}
+
+	public:
+
+		void Finalize( void ) override { fBegin_Nodes.Finalize(); fWhile_Nodes.Finalize(); }
+
+		[[nodiscard]] size_type GetHeapBytes( void ) const override { return fBegin_Nodes.GetHeapBytes() + fWhile_Nodes.GetHeapBytes(); }
+
+	public:
+
+		void operator () ( void ) override
+		{
+			try
+			{
+				// ---------------------
+				do
+				{
+					fBegin_Nodes();		
+				}
+				while( fInternalFun() );
+				// ---------------------
+
+			}
+			catch( typename LEAVE< Base >::LEAVE_Exception & )
+			{
+				// this one is special for LEAVE - everything is under control, just return
+				return;
+			}
+			// all other potential exceptions go to upper layers
+
+
+		}
+
+	};
+
+
+
+	// It can be associated with a BEGIN ... loop 
+	// and when executed it makes the loop to break
+	template < typename Base >
+	class EXIT_BEGIN_LOOP : public TWord< Base >
+	{
+		BEGIN_LOOP< Base > &	fMyBeginNode;
+
+	public:
+
+		EXIT_BEGIN_LOOP( Base & f, BEGIN_LOOP< Base > & my_loop ) : TWord< Base >( f ), fMyBeginNode( my_loop ) {}
+
+	public:
+
+		void operator () ( void ) override
+		{
+			fMyBeginNode.SetLoopType( BEGIN_LOOP< Base >::EBeginLoopType::kExit );
+		}
+
+	};
+
+
+
+	// Just a placeholder
+	template < typename Base >
+	class CASE : public CompoWord< Base >
+	{
+		using BaseClass = CompoWord< Base >;
+
+	public:
+
+		using BaseClass::AddWord;
+
+	public:
+
+		CASE( Base & f ) : BaseClass( f ) {}
+
+	public:
+
+		void operator () ( void ) override
+		{
+			BaseClass::operator() ();		// call the base composite
+		}
+
+	};
+
+
+
+
+
+
+	// ------------------------
+	// Creational pattern
+	//
+	//: ARRAY ( n -- ) CREATE DUP , CELLS ALLOT
+	//	DOES> ( n -- a ) SWAP OVER @ OVER < OVER 1 < OR ABORT" Out of range" 
+	//	CELLS + ;
+	//
+	//: MSG ( -- ) CREATE
+	//	DOES> ( -- ) COUNT TYPE ;
+	//
+	// MSG (CR)		2 C, 0D C, 0A C,
+	//
+
+	template < typename Base >
+	class DOES : public StructuralWord< Base >
+	{
+		using DataStack = typename Base::DataStack;
+		using StructuralWord< Base >::GetDataStack;
+
+		using CW = CompoWord< Base >;
+
+		CW	fCreationBranch;
+		CW	fBehaviorBranch;
+
+	public:
+
+		[[nodiscard]] CW &	GetCreationNode( void )		{ return fCreationBranch; }
+		[[nodiscard]] CW &	GetBehaviorNode( void )		{ return fBehaviorBranch; }
+
+	public:
+
+		DOES( Base & f ) : StructuralWord< Base >( f ), fCreationBranch( f ), fBehaviorBranch( f ) {}
+
+	public:
+
+		void Finalize( void ) override { fCreationBranch.Finalize(); fBehaviorBranch.Finalize(); }
+
+		[[nodiscard]] size_type GetHeapBytes( void ) const override { return fCreationBranch.GetHeapBytes() + fBehaviorBranch.GetHeapBytes(); }
+
+	public:
+
+		// 12 ARRAY SHUTTER
+		// ...
+		// 3 SHUTTER
+		//
+		// This needs to add a defining word into the dictionary
+		void operator () ( void ) override
+		{
+			assert( fCreationBranch.GetWordsVec().size() > 0 );
+			fCreationBranch();		// call the creational branch
+		}
+
+	};
+
+
+
+
+
+}	// The end of the BCForth namespace
+
+
+
+
+
@@ -1,453 +1,498 @@
-// ========================================================================
-//
-// The Forth interpreter-compiler by Prof. Boguslaw Cyganek (C) 2021
-//
-// The software is supplied as is and for educational purposes
-// without any guarantees nor responsibility of its use in any application. 
-//
-// ========================================================================
-
-
-#pragma once
-
-
-
-#include "StructWords.h"
-
-
-
-
-
-
-namespace BCForth
-{
-
-
-
-
-	// ------------------------
-	// System words
-
-
-	// ' <name>
-	template < typename Base >
-	class Tick : public TWord< Base >
-	{
-		using TWord< Base >::GetDataStack;
-		using typename TWord< Base >::WordPtr;
-		using TWord< Base >::GetForth;
-
-
-		const Name & fValueName;	// a name of the VALUE word 
-
-	public:
-
-		Tick( Base & f, const Name & value_name ) : TWord< Base >( f ), fValueName( value_name ) {}
-
-	public:
-
-		// Find a name and put its "token" onto the stack (i.e. its node ptr TWord< TForth > *, so it can be executed)
-		void operator () ( void ) override
-		{
-			if( auto word_entry = GetForth().GetWordEntry( fValueName ) )
-				GetDataStack().Push( reinterpret_cast< CellType >( ( * word_entry )->fWordUP.get()  ) );				
-			else
-				throw ForthError( "This word has not been defined" );
-		}
-
-	};
-
-
-	// EXECUTE
-	template < typename Base >
-	class Execute : public TWord< Base >
-	{
-		using TWord< Base >::GetDataStack;
-		using DataStack = typename Base::DataStack;
-
-	public:
-
-		Execute( Base & f ) : TWord< Base >( f ) {}
-
-	public:
-
-		void operator () ( void ) override
-		{
-			// Take an address from the stack and execute the word
-			if( typename DataStack::value_type word_addr {}; GetDataStack().Pop( word_addr ) )
-				( * reinterpret_cast< TWord< Base > * >( word_addr ) )();
-			else
-				throw ForthError( "unexpectedly empty stack" );
-		}
-
-	};
-
-
-
-
-
-	// Used to change content of the VALUE, e.g.
-	// 50 VALUE ACCELERATOR
-	// 100 TO ACCELERATOR
-	template < typename Base >
-	class To : public TWord< Base >
-	{
-		using TWord< Base >::GetDataStack;
-		using typename TWord< Base >::WordPtr;
-		using TWord< Base >::GetForth;
-
-		using DataStack = typename Base::DataStack;
-
-
-		const Name & fValueName;	// a name of the VALUE word 
-
-
-
-	public:
-
-		To( Base & f, const Name & value_name ) : TWord< Base >( f ), fValueName( value_name ) {}
-
-	public:
-
-
-		void operator () ( void ) override
-		{
-			if( auto word_entry = GetForth().GetWordEntry( fValueName ) )
-			{
-
-				if( auto * compo_wrd = dynamic_cast< CompoWord< Base > * >(  ( * word_entry )->fWordUP.get() ); compo_wrd && compo_wrd->GetWordsVec().size() > 0 )	// Ok, the word is found but check if this is a proper node
-				{
-					if( auto * val_array = dynamic_cast< RawByteArray< Base > * >(  compo_wrd->GetWordsVec()[ 0 ] ) ){	// Access the array in the compo word				
-
-						if( typename DataStack::value_type val {}; GetDataStack().Pop( val ) )		// Ok, try to pop the stack 
-						{							
-							assert( val_array->GetContainer().size() == sizeof( CellType ) );
-							* reinterpret_cast< typename DataStack::value_type * >( val_array->GetContainer().data() ) = val;
-							return;
-						}
-						else
-						{
-							throw ForthError( "unexpectedly empty stack" );
-						}
-					}
-				}
-
-
-				throw ForthError( "This word cannot be used in this context" );
-
-			}
-			else
-			{
-				throw ForthError( "This VALUE has not been defined" );
-			}
-
-		}
-
-
-	};
-
-
-
-
-	// Used in context like this 
-	// CREATE TENS  1 , 10 , 100 , 1000 , 10000 ,
-	// each value is set into a cell (not a byte)
-	// 
-	// VAL is a type of a value to push, e.g.
-	// it can be as above, or as in
-	// CREATE TEST 123 C, ALIGN 1234 ,
-	//
-	template < typename Base, typename VAL >
-	class Comma : public TWord< Base >
-	{
-		using TWord< Base >::GetDataStack;
-		using TWord< Base >::GetForth;
-
-
-		using DataStack = typename Base::DataStack;
-
-
-		using VAL_TYPE = VAL;
-
-	public:
-
-		Comma( Base & f ) : TWord< Base >( f ) {}
-
-	public:
-
-		void operator () ( void ) override
-		{
-
-			// CellVal node is on the node repo, whereas value to set is on the data stack - go for them
-			if( typename DataStack::value_type val {}; GetDataStack().Pop( val ) )
-			{
-
-				if( const auto & nrepo { GetForth().GetNodeRepo() }; nrepo.size() > 0 )
-
-					if( auto * cell_val_node = dynamic_cast< RawByteArray< Base > * >( nrepo[ nrepo.size() - 1 ].get() ) )
-					{
-						PushValTo( cell_val_node->GetContainer(), static_cast< VAL_TYPE >( val ) );
-						return;
-					}
-
-
-				throw ForthError( "no preceding CREATE to , (comma)" );
-
-			}
-			else
-			{
-				throw ForthError( "unexpectedly empty stack" );	
-			}
-
-		}
-
-
-	};
-
-
-	template < typename Base >
-	class CommaQuote : public TWord< Base >
-	{
-		using TWord< Base >::GetDataStack;
-		using TWord< Base >::GetForth;
-
-
-		using DataStack = typename Base::DataStack;
-
-
-		const Name & fStr;
-
-	public:
-
-		CommaQuote( Base & f, const Name & str ) : TWord< Base >( f ), fStr( str ) {}
-
-	public:
-
-		void operator () ( void ) override
-		{
-			if( const auto & nrepo { GetForth().GetNodeRepo() }; nrepo.size() > 0 )
-
-				if( auto * cell_val_node = dynamic_cast< RawByteArray< Base > * >( nrepo[ nrepo.size() - 1 ].get() ) )
-				{
-						
-					auto str_len { fStr.length() };
-					assert( str_len <= 255 );
-					PushValTo( cell_val_node->GetContainer(), static_cast< RawByte >( str_len ) );
-					std::for_each( fStr.begin(), fStr.end(), [ & arr = cell_val_node->GetContainer() ] ( const auto c ) { PushValTo( arr, static_cast< RawByte >( c ) ); } );
-
-					return;
-				}
-
-
-			throw ForthError( "no preceding CREATE to ,\" (comma-quote)" );
-		}
-
-
-	};
-
-
-
-
-	// Allocate n bytes for the array - however we use the cell-type array
-	// Used in context like this 
-	// 
-	// CREATE DATA  100 ALLOT
-	// DATA  100 ERASE
-	// 
-	// CREATE CELL-DATA  100 CELLS ALLOT
-	//
-	template < typename Base >
-	class Allot : public TWord< Base >
-	{
-		using TWord< Base >::GetDataStack;
-		using typename TWord< Base >::WordPtr;
-		using TWord< Base >::GetForth;
-
-
-		using DataStack = typename Base::DataStack;
-
-
-	public:
-
-		Allot( Base & f ) : TWord< Base >( f ) {}
-
-	public:
-
-
-		void operator () ( void ) override
-		{	
-			// CellVal node is on the node repo, whereas num of bytes to allocate is on the data stack - go for them
-			if( typename DataStack::value_type size_2_alloc_in_bytes {}; GetDataStack().Pop( size_2_alloc_in_bytes ) )
-			{
-
-				if( const auto & nrepo { GetForth().GetNodeRepo() }; nrepo.size() > 0 )
-
-					if( auto * cell_val_node = dynamic_cast< RawByteArray< Base > * >( nrepo[ nrepo.size() - 1 ].get() ) )
-					{
-						cell_val_node->GetContainer().resize( cell_val_node->GetContainer().size() + size_2_alloc_in_bytes );	// append the new size, i.e. keep the previous allocations
-						return;																									// this makes possible interaction with prior ,
-					}
-
-
-				throw ForthError( "no preceding CREATE to ALLOT" );
-
-			}
-			else
-			{
-				throw ForthError( "unexpectedly empty stack" );	
-			}
-
-
-		}
-
-
-	};
-
-
-
-
-
-	// CREATE
-	// It will be compiled into the creat words with DOES>
-	// It will execute during definition of the instance word
-	//
-	// CREATE DATA  100 ALLOT
-	// DATA  100 ERASE
-	// 
-	// CREATE CELL-DATA  100 CELLS ALLOT
-	//
-	template < typename Base >
-	class Create : public TWord< Base >
-	{
-		using TWord< Base >::GetDataStack;
-		using typename TWord< Base >::WordPtr;
-		using WordUP = typename Base::WordUP;
-		using TWord< Base >::GetForth;
-
-	public:
-
-		Create( Base & f ) : TWord< Base >( f ) {}
-
-	public:
-
-
-		void operator () ( void ) override
-		{
-			// When Create executes the RawByteArray node is created. It needs to be associated with the subsequent
-			// word whose name is next in the input stream after the defining word (i.e. the one containing this CREATE)
-			GetForth().Insert_2_NodeRepo( std::make_unique< RawByteArray< Base > >( GetForth() ) );
-		}
-
-
-	};
-
-
-
-	// Just display the contained text
-	template < typename Base >
-	class Abort : public TWord< Base >
-	{
-	protected:
-
-		using TWord< Base >::GetDataStack;
-		using TWord< Base >::GetForth;
-
-		Name		fText;
-
-	public:
-
-		Abort( Base & f, Name s = "" ) : TWord< Base >( f ), fText( s ) {}
-
-	public:
-
-		void operator () ( void ) override
-		{
-			// The base ABORT operates as follows:
-			// (1) Clear the stacks
-			// (2) Unconditionally terminate execution
-
-			GetDataStack().clear();
-			GetForth().GetRetStack().clear();
-
-			throw fText;
-		}
-
-	};
-
-
-	template < typename Base >
-	class AbortQuote : public Abort< Base >
-	{
-	protected:
-
-		using MyBase = Abort< Base >;
-
-		using DS = typename Base::DataStack;
-		using MyBase::GetDataStack;
-		using MyBase::GetForth;
-
-
-	public:
-
-		AbortQuote( Base & f, Name s = "" ) : MyBase( f, s ) {}
-
-	public:
-
-		void operator () ( void ) override
-		{
-			if( typename DS::value_type word_addr {}; GetDataStack().Pop( word_addr ) )
-			{
-				if( word_addr )					// if flag is true (non-zero)
-					MyBase::operator () ();		// call the base ABORT to clear the stacks and throw
-			}
-			else
-			{
-				throw ForthError( "unexpectedly empty stack" );
-			}
-		}
-
-	};
-
-
-
-	// POSTPONE <name>
-	// Usually in the context like this:
-	// : XXXX DUP POSTPONE WORD_A DROP POSTPONE WORD_B ; IMMEDIATE
-	// ...
-	// : Scnd BLA BLA   XXXX   BLA ;
-	// Because XXXX is immediate it will be immediately executed during compilation
-	// except its two postponed words WORD_A and WORD_B. Hence, the above will evaluate to something like:
-	// : Scnd BLA BLA   WORD_A  WORD_B  BLA ;
-	//
-	template < typename Base >
-	class Postpone : public TWord< Base >
-	{
-		using typename TWord< Base >::WordPtr;
-		using TWord< Base >::GetForth;
-
-		const WordPtr	fWordPtr;	// this is the "postponed" word, i.e. it had been encountered during compilation
-									// but was preceded by POSTPONE - because of this it hasn't been executed but 
-									// compiled into the word being compiled
-
-	public:
-
-		Postpone( Base & f, const WordPtr w_ptr ) : TWord< Base >( f ), fWordPtr( w_ptr ) {}
-
-	public:
-
-		// Do an exception ** when compiling an immediate word ** with some of its sub-words
-		// indicated as POSTPONE, though. In such a case, these sub-words will be compiled-in,
-		// rathern than being executed with the rest of the immediated word. 
-		// However, if not in the "compiling immdediate" mode, then such a word will be simply executed.
-		void operator () ( void ) override;
-
-	};
-
-
-
-
-}	// The end of the BCForth namespace
-
-
-
-
+// ========================================================================
+//
+// The Forth interpreter-compiler by Prof. Boguslaw Cyganek (C) 2021
+//
+// The software is supplied as is and for educational purposes
+// without any guarantees nor responsibility of its use in any application. 
+//
+// ========================================================================
+
+
+#pragma once
+
+
+
+#include "StructWords.h"
+
+
+
+
+
+
+namespace BCForth
+{
+
+
+
+
+	// ------------------------
+	// System words
+
+
+	// ' <name>
+	template < typename Base >
+	class Tick : public TWord< Base >
+	{
+		using TWord< Base >::GetDataStack;
+		using typename TWord< Base >::WordPtr;
+		using TWord< Base >::GetForth;
+
+
+		const Name & fValueName;	// a name of the VALUE word 
+
+	public:
+
+		Tick( Base & f, const Name & value_name ) : TWord< Base >( f ), fValueName( value_name ) {}
+
+	public:
+
+		// Find a name and put its "token" onto the stack (i.e. its node ptr TWord< TForth > *, so it can be executed)
+		void operator () ( void ) override
+		{
+			if( auto word_entry = GetForth().GetWordEntry( fValueName ) )
+				GetDataStack().Push( reinterpret_cast< CellType >( ( * word_entry )->fWordUP.get()  ) );				
+			else
+				throw ForthError( "This word has not been defined" );
+		}
+
+	};
+
+
+	// EXECUTE
+	template < typename Base >
+	class Execute : public TWord< Base >
+	{
+		using TWord< Base >::GetDataStack;
+		using DataStack = typename Base::DataStack;
+
+	public:
+
+		Execute( Base & f ) : TWord< Base >( f ) {}
+
+	public:
+
+		void operator () ( void ) override
+		{
+			// Take an address from the stack and execute the word
+			if( typename DataStack::value_type word_addr {}; GetDataStack().Pop( word_addr ) )
+				( * reinterpret_cast< TWord< Base > * >( word_addr ) )();
+			else
+				throw ForthError( "unexpectedly empty stack" );
+		}
+
+	};
+
+
+
+
+
+	// Used to change content of the VALUE, e.g.
+	// 50 VALUE ACCELERATOR
+	// 100 TO ACCELERATOR
+	template < typename Base >
+	class To : public TWord< Base >
+	{
+		using TWord< Base >::GetDataStack;
+		using typename TWord< Base >::WordPtr;
+		using TWord< Base >::GetForth;
+
+		using DataStack = typename Base::DataStack;
+
+
+		const Name & fValueName;	// a name of the VALUE word 
+
+
+
+	public:
+
+		To( Base & f, const Name & value_name ) : TWord< Base >( f ), fValueName( value_name ) {}
+
+	private:
+
+		// True if the word was made by the defining word, i.e. its behavior is the DOES> part of that defining word.
+		// So only a VALUE or an FVALUE can be changed - not a CONSTANT, although it has the same DOES> @ part,
+		// nor any other CREATEd word, whose data field may not hold a cell.
+		bool IsDefinedBy( CompoWord< Base > & compo_wrd, const Name & defining_name )
+		{
+			if( compo_wrd.GetWordsVec().size() < 2 )
+				return false;
+
+			const auto defining_entry = GetForth().GetWordEntry( defining_name );
+			if( ! defining_entry )
+				return false;
+
+			auto * defining_wrd = dynamic_cast< CompoWord< Base > * >( ( * defining_entry )->fWordUP.get() );
+			if( defining_wrd == nullptr || defining_wrd->GetWordsVec().size() == 0 )
+				return false;
+
+			auto * does_wrd = dynamic_cast< DOES< Base > * >( defining_wrd->GetWordsVec()[ 0 ] );
+			return does_wrd && compo_wrd.GetWordsVec()[ 1 ] == & does_wrd->GetBehaviorNode();
+		}
+
+		template < typename S >
+		void SetVal( S & stack, DataField< Base > * data_field )
+		{
+			if( typename S::value_type val {}; stack.Pop( val ) )		// Ok, try to pop the stack 
+			{							
+				std::memcpy( data_field->GetBody(), & val, sizeof( val ) );
+			}
+			else
+			{
+				throw ForthError( "unexpectedly empty stack" );
+			}
+		}
+
+	public:
+
+
+		void operator () ( void ) override
+		{
+			if( auto word_entry = GetForth().GetWordEntry( fValueName ) )
+			{
+
+				if( auto * compo_wrd = dynamic_cast< CompoWord< Base > * >(  ( * word_entry )->fWordUP.get() ); compo_wrd && compo_wrd->GetWordsVec().size() > 0 )	// Ok, the word is found but check if this is a proper node
+				{
+					if( auto * data_field = dynamic_cast< DataField< Base > * >(  compo_wrd->GetWordsVec()[ 0 ] ) ){	// Access the data field in the compo word				
+
+						if( IsDefinedBy( * compo_wrd, "FVALUE" ) )
+						{
+							SetVal( GetForth().GetFloatStack(), data_field );
+							return;
+						}
+
+						if( IsDefinedBy( * compo_wrd, "VALUE" ) )
+						{
+							SetVal( GetDataStack(), data_field );
+							return;
+						}
+					}
+				}
+
+
+				throw ForthError( "This word cannot be used in this context" );
+
+			}
+			else
+			{
+				throw ForthError( "This VALUE has not been defined" );
+			}
+
+		}
+
+
+	};
+
+
+
+
+	// Used in context like this 
+	// CREATE TENS  1 , 10 , 100 , 1000 , 10000 ,
+	// each value is set into a cell (not a byte)
+	// 
+	// VAL is a type of a value to push, e.g.
+	// it can be as above, or as in
+	// CREATE TEST 123 C, ALIGN 1234 ,
+	//
+	// The value goes to HERE in the data space, so the data can also be laid down with no CREATE.
+	template < typename Base, typename VAL >
+	class Comma : public TWord< Base >
+	{
+		using TWord< Base >::GetDataStack;
+		using TWord< Base >::GetForth;
+
+
+		using DataStack = typename Base::DataStack;
+
+
+		using VAL_TYPE = VAL;
+
+	public:
+
+		Comma( Base & f ) : TWord< Base >( f ) {}
+
+	public:
+
+		void operator () ( void ) override
+		{
+
+			// The value to set is on the data stack (or on the floating-point stack) - go for it
+			auto & stack = GetStackOf< VAL_TYPE >( GetForth() );
+			if( typename std::remove_reference_t< decltype( stack ) >::value_type val {}; stack.Pop( val ) )
+			{
+				GetForth().GetDataSpace().Comma( static_cast< VAL_TYPE >( val ) );
+			}
+			else
+			{
+				throw ForthError( "unexpectedly empty stack" );	
+			}
+
+		}
+
+
+	};
+
+
+	template < typename Base >
+	class CommaQuote : public TWord< Base >
+	{
+		using TWord< Base >::GetDataStack;
+		using TWord< Base >::GetForth;
+
+
+		using DataStack = typename Base::DataStack;
+
+
+		const Name & fStr;
+
+	public:
+
+		CommaQuote( Base & f, const Name & str ) : TWord< Base >( f ), fStr( str ) {}
+
+	public:
+
+		void operator () ( void ) override
+		{
+			// A counted string - the length byte, then the characters
+			auto str_len { fStr.length() };
+			assert( str_len <= 255 );
+
+			auto * dst { GetForth().GetDataSpace().Allot( static_cast< SignedIntType >( str_len + 1 ) ) };
+			* dst ++ = static_cast< RawByte >( str_len );
+			std::copy( fStr.begin(), fStr.end(), dst );
+		}
+
+
+	};
+
+
+
+
+	// Allocate n bytes at HERE in the data space (a negative n gives them back)
+	// Used in context like this 
+	// 
+	// CREATE DATA  100 ALLOT
+	// DATA  100 ERASE
+	// 
+	// CREATE CELL-DATA  100 CELLS ALLOT
+	//
+	template < typename Base >
+	class Allot : public TWord< Base >
+	{
+		using TWord< Base >::GetDataStack;
+		using typename TWord< Base >::WordPtr;
+		using TWord< Base >::GetForth;
+
+
+		using DataStack = typename Base::DataStack;
+
+
+	public:
+
+		Allot( Base & f ) : TWord< Base >( f ) {}
+
+	public:
+
+
+		void operator () ( void ) override
+		{	
+			// The num of bytes to allocate is on the data stack - go for it
+			if( typename DataStack::value_type size_2_alloc_in_bytes {}; GetDataStack().Pop( size_2_alloc_in_bytes ) )
+			{
+				GetForth().GetDataSpace().Allot( static_cast< SignedIntType >( size_2_alloc_in_bytes ) );		// just after the prior , or ALLOT
+			}
+			else
+			{
+				throw ForthError( "unexpectedly empty stack" );	
+			}
+
+
+		}
+
+
+	};
+
+
+
+
+
+	// CREATE
+	// It will be compiled into the creat words with DOES>
+	// It will execute during definition of the instance word
+	//
+	// CREATE DATA  100 ALLOT
+	// DATA  100 ERASE
+	// 
+	// CREATE CELL-DATA  100 CELLS ALLOT
+	//
+	template < typename Base >
+	class Create : public TWord< Base >
+	{
+		using TWord< Base >::GetDataStack;
+		using typename TWord< Base >::WordPtr;
+		using WordUP = typename Base::WordUP;
+		using TWord< Base >::GetForth;
+
+	public:
+
+		Create( Base & f ) : TWord< Base >( f ) {}
+
+	public:
+
+
+		void operator () ( void ) override
+		{
+			// When Create executes the DataField node is created at the aligned HERE. It needs to be associated with the subsequent
+			// word whose name is next in the input stream after the defining word (i.e. the one containing this CREATE)
+			auto & data_space { GetForth().GetDataSpace() };
+			data_space.MarkDataField();
+			data_space.Align();
+			GetForth().Insert_2_NodeRepo( std::make_unique< DataField< Base > >( GetForth(), data_space.Here() ) );
+		}
+
+
+	};
+
+
+
+
+	// MARKER <name>
+	// Created with a snapshot of the dictionary. When executed, it removes itself and all words 
+	// defined after it, restores the words they redefined, and frees their nodes.
+	//
+	// MARKER -APP
+	// ... the application words ...
+	// -APP			\ back to the state before MARKER
+	//
+	template < typename Base >
+	class Marker : public TWord< Base >
+	{
+		using TWord< Base >::GetForth;
+
+		using DictCheckpoint = typename Base::DictCheckpoint;
+
+		const DictCheckpoint	fCheckpoint;
+
+	public:
+
+		Marker( Base & f, DictCheckpoint cp ) : TWord< Base >( f ), fCheckpoint( std::move( cp ) ) {}
+
+	public:
+
+		void operator () ( void ) override
+		{
+			GetForth().RollBackDictionary( fCheckpoint );		// this object is removed too, but released later
+		}
+
+	};
+
+
+
+	// Just display the contained text
+	template < typename Base >
+	class Abort : public TWord< Base >
+	{
+	protected:
+
+		using TWord< Base >::GetDataStack;
+		using TWord< Base >::GetForth;
+
+		Name		fText;
+
+	public:
+
+		Abort( Base & f, Name s = "" ) : TWord< Base >( f ), fText( s ) {}
+
+	public:
+
+		void operator () ( void ) override
+		{
+			// The base ABORT operates as follows:
+			// (1) Clear the stacks
+			// (2) Unconditionally terminate execution
+
+			GetDataStack().clear();
+			GetForth().GetRetStack().clear();
+			GetForth().GetFloatStack().clear();
+
+			throw fText;
+		}
+
+	};
+
+
+	template < typename Base >
+	class AbortQuote : public Abort< Base >
+	{
+	protected:
+
+		using MyBase = Abort< Base >;
+
+		using DS = typename Base::DataStack;
+		using MyBase::GetDataStack;
+		using MyBase::GetForth;
+
+
+	public:
+
+		AbortQuote( Base & f, Name s = "" ) : MyBase( f, s ) {}
+
+	public:
+
+		void operator () ( void ) override
+		{
+			if( typename DS::value_type word_addr {}; GetDataStack().Pop( word_addr ) )
+			{
+				if( word_addr )					// if flag is true (non-zero)
+					MyBase::operator () ();		// call the base ABORT to clear the stacks and throw
+			}
+			else
+			{
+				throw ForthError( "unexpectedly empty stack" );
+			}
+		}
+
+	};
+
+
+
+	// POSTPONE <name>
+	// Usually in the context like this:
+	// : XXXX DUP POSTPONE WORD_A DROP POSTPONE WORD_B ; IMMEDIATE
+	// ...
+	// : Scnd BLA BLA   XXXX   BLA ;
+	// Because XXXX is immediate it will be immediately executed during compilation
+	// except its two postponed words WORD_A and WORD_B. Hence, the above will evaluate to something like:
+	// : Scnd BLA BLA   WORD_A  WORD_B  BLA ;
+	//
+	template < typename Base >
+	class Postpone : public TWord< Base >
+	{
+		using typename TWord< Base >::WordPtr;
+		using TWord< Base >::GetForth;
+
+		const WordPtr	fWordPtr;	// this is the "postponed" word, i.e. it had been encountered during compilation
+									// but was preceded by POSTPONE - because of this it hasn't been executed but 
+									// compiled into the word being compiled
+
+	public:
+
+		Postpone( Base & f, const WordPtr w_ptr ) : TWord< Base >( f ), fWordPtr( w_ptr ) {}
+
+	public:
+
+		// Do an exception ** when compiling an immediate word ** with some of its sub-words
+		// indicated as POSTPONE, though. In such a case, these sub-words will be compiled-in,
+		// rathern than being executed with the rest of the immediated word. 
+		// However, if not in the "compiling immdediate" mode, then such a word will be simply executed.
+		void operator () ( void ) override;
+
+	};
+
+
+
+
+}	// The end of the BCForth namespace
+
+
+
+
@@ -1,77 +1,136 @@
-// ========================================================================
-//
-// The Forth interpreter-compiler by Prof. Boguslaw Cyganek (C) 2021
-//
-// The software is supplied as is and for educational purposes
-// without any guarantees nor responsibility of its use in any application. 
-//
-// ========================================================================
-
-
-
-#include "Interfaces.h"
-
-#include "FiberRoutines.h"
-#include "ESP32_config.h"
-#include <numbers>
-
-
-#include <cassert>
-#include <memory>
-
-//template < typename S, typename T >
-//[[nodiscard]] constexpr S BlindValueReInterpretation_UBSafe( T t_val )
-//{
-	// These can lead to UB ...
-	//if constexpr ( sizeof( S ) > sizeof( T ) )
-	//	return ( * reinterpret_cast< S * >( & t_val ) ) & ( ( 1ull << sizeof( T ) * 8 ) - 1 );		// cut out excessive value (i.e. clear the bits from MSB up to bit_len( T )
-	//else
-	//	return * reinterpret_cast< S * >( & t_val );
-
-//	return * std::start_lifetime_as< S >( & t_val );
-//}
-
-
-void ConverTest()
-{
-	constexpr BCForth::CellType	kCellVal { 0x0123456789ABCDEF };
-
-	std::byte b = BCForth::BlindValueReInterpretation< std::byte >( kCellVal );
-
-	//assert( b == 0xEF );		// won't compile
-	assert( std::to_integer< unsigned int >( b ) == 0xEF );
-
-	BCForth::CellType tmp { kCellVal };
-	assert( tmp == kCellVal );
-
-
-	tmp = BCForth::BlindValueReInterpretation< BCForth::CellType >( b );
-	assert( tmp == 0x00000000000000EF );
-
-	// ---
-	//std::byte bb = BlindValueReInterpretation_UBSafe< std::byte >( kCellVal );
-	//assert( std::to_integer< unsigned int >( bb ) == 0xEF );
-
-
-}
-
-
-void MemTest()
-{
-	std::cout << "sizeof( BCForth::Name ) = "				<< sizeof( BCForth::Name )					<< std::endl;
-	std::cout << "sizeof( BCForth::DebugFileInfo ) = " << sizeof( BCForth::DebugFileInfo )		<< std::endl;
-	std::cout << "sizeof( BCForth::Token ) = "			<< sizeof( BCForth::Token )				<< std::endl;
-}
-
-
-
-
-
-extern "C" void app_main(void){
-	ESP32::register_spiffs();
-	ESP32::configure();
-	BCForth::Run();
-	ESP32::unregister_spiffs();
-}
-
-
+// ========================================================================
+//
+// The Forth interpreter-compiler by Prof. Boguslaw Cyganek (C) 2021
+//
+// The software is supplied as is and for educational purposes
+// without any guarantees nor responsibility of its use in any application. 
+//
+// ========================================================================
+
+
+
+#include "Interfaces.h"
+
+#include "FiberRoutines.h"
+#ifdef ESP_PLATFORM
+#include "ESP32_config.h"
+#endif
+#include <numbers>
+
+
+#include <cassert>
+#include <memory>
+#include <cstdlib>
+
+//template < typename S, typename T >
+//[[nodiscard]] constexpr S BlindValueReInterpretation_UBSafe( T t_val )
+//{
+	// These can lead to UB ...
+	//if constexpr ( sizeof( S ) > sizeof( T ) )
+	//	return ( * reinterpret_cast< S * >( & t_val ) ) & ( ( 1ull << sizeof( T ) * 8 ) - 1 );		// cut out excessive value (i.e. clear the bits from MSB up to bit_len( T )
+	//else
+	//	return * reinterpret_cast< S * >( & t_val );
+
+//	return * std::start_lifetime_as< S >( & t_val );
+//}
+
+
+void ConverTest()
+{
+	constexpr BCForth::CellType	kCellVal { 0x0123456789ABCDEF };
+
+	std::byte b = BCForth::BlindValueReInterpretation< std::byte >( kCellVal );
+
+	//assert( b == 0xEF );		// won't compile
+	assert( std::to_integer< unsigned int >( b ) == 0xEF );
+
+	BCForth::CellType tmp { kCellVal };
+	assert( tmp == kCellVal );
+
+
+	tmp = BCForth::BlindValueReInterpretation< BCForth::CellType >( b );
+	assert( tmp == 0x00000000000000EF );
+
+	// ---
+	//std::byte bb = BlindValueReInterpretation_UBSafe< std::byte >( kCellVal );
+	//assert( std::to_integer< unsigned int >( bb ) == 0xEF );
+
+
+}
+
+
+void MemTest()
+{
+	std::cout << "sizeof( BCForth::Name ) = "				<< sizeof( BCForth::Name )					<< std::endl;
+	std::cout << "sizeof( BCForth::DebugFileInfo ) = " << sizeof( BCForth::DebugFileInfo )		<< std::endl;
+	std::cout << "sizeof( BCForth::Token ) = "			<< sizeof( BCForth::Token )				<< std::endl;
+}
+
+
+
+
+
+#ifdef ESP_PLATFORM
+
+extern "C" void app_main(void){
+	ESP32::register_spiffs();
+	ESP32::configure();
+	BCForth::Run();
+	ESP32::unregister_spiffs();
+}
+
+#else
+
+// On the host, with no arguments this runs the interactive REPL.
+// Otherwise, this is the batch mode:
+//
+//		bcforth [-q] [-b] [-t] [-k] [-s cells] [-g cells] [-d bytes] file ... | -
+//
+//		-q	quiet - nothing goes to the standard output, since all the words (also FIND) print through the output sink;
+//			the errors still go to the standard error
+//		-b	buffer the output (flush when the buffer gets full)
+//		-t	print the processing time of each file
+//		-k	keep going after errors
+//		-s	the size of the data stack (in cells)
+//		-g	let the data stack grow up to that size (in cells)
+//		-d	the size of the data space (in bytes)
+//		-	read the standard input
+//
+// The exit status is 0 if all files were processed with no errors.
+int main( int argc, char ** argv )
+{
+	if( argc < 2 )
+	{
+		BCForth::Run();
+		return EXIT_SUCCESS;
+	}
+
+	BCForth::BatchOptions	options;
+	BCForth::Names			sources;
+
+	for( int i { 1 }; i < argc; ++ i )
+	{
+		const std::string_view arg { argv[ i ] };
+
+		if( arg == "-q" )
+			options.fSuppressOutput = true;
+		else if( arg == "-b" )
+			options.fBufferOutput = true;
+		else if( arg == "-t" )
+			options.fPrintTiming = true;
+		else if( arg == "-k" )
+			options.fStopOnError = false;
+		else if( ( arg == "-s" || arg == "-g" ) && i + 1 < argc )
+			( arg == "-s" ? options.fForthConfig.fDataStackCells : options.fForthConfig.fMaxDataStackCells ) = std::strtoul( argv[ ++ i ], nullptr, 10 );
+		else if( arg == "-d" && i + 1 < argc )
+			options.fForthConfig.fDataSpaceBytes = std::strtoul( argv[ ++ i ], nullptr, 10 );
+		else
+			sources.emplace_back( arg );
+	}
+
+	return BCForth::RunBatch( sources, options );
+}
+
+#endif
+
+